@@ -0,0 +1,153 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+// Stress benchmark of FLuaPoolAllocator against plain malloc, see LUA_BUILD_BENCHMARKS in CMakeLists.txt
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "lua.hpp"
+#include "LuaPoolAllocator.h"
+
+using UnLua::FLuaPoolAllocator;
+
+static void* MallocAllocator(void* /*UserData*/, void* Ptr, size_t /*OldSize*/, size_t NewSize)
+{
+    if (NewSize == 0)
+    {
+        free(Ptr);
+        return nullptr;
+    }
+    return realloc(Ptr, NewSize);
+}
+
+static FLuaPoolAllocator::FStats LiveStats;
+
+static double Now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const char* Workload = R"(
+    local N = ...
+    local Objects = {}
+    for i = 1, N do
+        local t = { x = i, y = i * 2, name = "obj" .. i }
+        t.f = function() return t.x + t.y end
+        Objects[i % 1024 + 1] = t
+        if i % 16 == 0 then
+            local s = {}
+            for j = 1, 8 do s[j] = tostring(i + j) end
+            Objects[(i * 7) % 1024 + 1] = table.concat(s, ",")
+        end
+    end
+    return #Objects
+)";
+
+static void PrintStats(const FLuaPoolAllocator::FStats& Stats)
+{
+    printf("    pages=%zu high_water=%zuKB small_allocs=%zu large_allocs=%zu fragmentation=%.1f%%\n",
+           Stats.Pages, Stats.HighWater / 1024, Stats.SmallAllocs, Stats.LargeAllocs, Stats.GetFragmentation() * 100);
+}
+
+static double RunLua(lua_Alloc Alloc, void* UserData, const int N)
+{
+    lua_State* L = lua_newstate(Alloc, UserData);
+    luaL_openlibs(L);
+    if (luaL_loadstring(L, Workload) != LUA_OK)
+    {
+        fprintf(stderr, "%s\n", lua_tostring(L, -1));
+        exit(1);
+    }
+
+    const double Start = Now();
+    lua_pushinteger(L, N);
+    if (lua_pcall(L, 1, 1, 0) != LUA_OK)
+    {
+        fprintf(stderr, "%s\n", lua_tostring(L, -1));
+        exit(1);
+    }
+    const double Elapsed = Now() - Start;
+
+    // stats of live heap before closing
+    if (Alloc == FLuaPoolAllocator::Alloc)
+        LiveStats = static_cast<FLuaPoolAllocator*>(UserData)->GetStats();
+    lua_close(L);
+    if (Alloc == FLuaPoolAllocator::Alloc)
+        static_cast<FLuaPoolAllocator*>(UserData)->ReleasePages();
+    return Elapsed;
+}
+
+static double RunChurn(lua_Alloc Alloc, void* UserData, const int N)
+{
+    struct FBlock
+    {
+        void* Ptr;
+        size_t Size;
+    };
+
+    std::mt19937 Random(42);
+    std::vector<FBlock> Blocks(4096, FBlock{nullptr, 0});
+
+    const double Start = Now();
+    for (int i = 0; i < N; i++)
+    {
+        auto& Block = Blocks[Random() % Blocks.size()];
+        // mostly small blocks as lua does, some large ones
+        const size_t Size = Random() % 16 == 0 ? 256 + Random() % 4096 : 8 + Random() % 120;
+        if (Block.Ptr && Random() % 4 == 0)
+            Block.Ptr = Alloc(UserData, Block.Ptr, Block.Size, Size);
+        else
+        {
+            Alloc(UserData, Block.Ptr, Block.Size, 0);
+            Block.Ptr = Alloc(UserData, nullptr, 0, Size);
+        }
+        Block.Size = Size;
+    }
+    const double Elapsed = Now() - Start;
+
+    if (Alloc == FLuaPoolAllocator::Alloc)
+        LiveStats = static_cast<FLuaPoolAllocator*>(UserData)->GetStats();
+    for (auto& Block : Blocks)
+        Alloc(UserData, Block.Ptr, Block.Size, 0);
+    if (Alloc == FLuaPoolAllocator::Alloc)
+        static_cast<FLuaPoolAllocator*>(UserData)->ReleasePages();
+    return Elapsed;
+}
+
+int main(int argc, char** argv)
+{
+    const int N = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    printf("lua workload, N=%d\n", N);
+    printf("  malloc: %.3fs\n", RunLua(MallocAllocator, nullptr, N));
+    {
+        FLuaPoolAllocator Allocator(MallocAllocator);
+        printf("  pooled: %.3fs\n", RunLua(FLuaPoolAllocator::Alloc, &Allocator, N));
+        PrintStats(LiveStats);
+    }
+
+    printf("allocation churn, N=%d\n", N * 10);
+    printf("  malloc: %.3fs\n", RunChurn(MallocAllocator, nullptr, N * 10));
+    {
+        FLuaPoolAllocator Allocator(MallocAllocator);
+        printf("  pooled: %.3fs\n", RunChurn(FLuaPoolAllocator::Alloc, &Allocator, N * 10));
+        PrintStats(LiveStats);
+    }
+
+    return 0;
+}
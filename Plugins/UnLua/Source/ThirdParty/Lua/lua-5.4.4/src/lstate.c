@@ -364,6 +364,8 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
   g->currentwhite = bitmask(WHITE0BIT);
   L->marked = luaC_white(g);
   preinit_thread(L, g);
+  /* UnLua: extra space of main thread is never garbage, states created by others read NULL env */
+  memset(lua_getextraspace(L), 0, LUA_EXTRASPACE);
   g->allgc = obj2gco(L);  /* by now, only object is the main thread */
   L->next = NULL;
   incnny(L);  /* main thread is always non yieldable */
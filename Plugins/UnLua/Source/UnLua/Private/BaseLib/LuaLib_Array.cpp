@@ -526,16 +526,277 @@ static int32 TArray_ToTable(lua_State* L)
     FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
     TArray_Guard(L, Array);
 
-    lua_newtable(L);
-    Array->Inner->Initialize(Array->ElementCache);
-    for (int32 i = 0; i < Array->Num(); ++i)
+    Array->ToTable(L);
+    return 1;
+}
+
+static const char* ARRAY_VIEW_METATABLE = "TArrayView";
+
+static FORCEINLINE void TArrayView_Push(lua_State* L, int64 Value) { lua_pushinteger(L, Value); }
+static FORCEINLINE void TArrayView_Push(lua_State* L, double Value) { lua_pushnumber(L, Value); }
+
+static FORCEINLINE void TArrayView_To(lua_State* L, int32 Index, int32& Out) { Out = (int32)lua_tointeger(L, Index); }
+static FORCEINLINE void TArrayView_To(lua_State* L, int32 Index, uint8& Out) { Out = (uint8)lua_tointeger(L, Index); }
+static FORCEINLINE void TArrayView_To(lua_State* L, int32 Index, float& Out) { Out = (float)lua_tonumber(L, Index); }
+static FORCEINLINE void TArrayView_To(lua_State* L, int32 Index, double& Out) { Out = (double)lua_tonumber(L, Index); }
+
+template <typename T>
+struct TArrayViewValue
+{
+    typedef int64 Type;
+};
+
+template <>
+struct TArrayViewValue<float>
+{
+    typedef double Type;
+};
+
+template <>
+struct TArrayViewValue<double>
+{
+    typedef double Type;
+};
+
+/**
+ * Call the visitor with the typed address of the first element in the view
+ */
+template <typename VisitorType>
+static FORCEINLINE int32 TArrayView_Visit(const FLuaArrayView* View, void* Data, VisitorType&& Visitor)
+{
+    switch (View->Kind)
     {
-        lua_pushinteger(L, i + 1);
-        Array->Get(i, Array->ElementCache);
-        Array->Inner->ReadValue(L, Array->ElementCache, true);
-        lua_rawset(L, -3);
+    case FLuaArray::EElementKind::Int32:
+        return Visitor((int32*)Data);
+    case FLuaArray::EElementKind::Float:
+        return Visitor((float*)Data);
+    case FLuaArray::EElementKind::Double:
+        return Visitor((double*)Data);
+    default:
+        return Visitor((uint8*)Data);
     }
-    Array->Inner->Destruct(Array->ElementCache);
+}
+
+/**
+ * Get the view and the array it pins, null array if the array was released by the dangling check
+ */
+static FORCEINLINE FLuaArray* TArrayView_Pin(lua_State* L, int32 Index, FLuaArrayView*& OutView)
+{
+    OutView = (FLuaArrayView*)luaL_checkudata(L, Index, ARRAY_VIEW_METATABLE);
+    lua_getuservalue(L, Index);
+    const auto Array = (FLuaArray*)GetCppInstanceFast(L, -1);  // still referenced by the view
+    lua_pop(L, 1);
+    return Array;
+}
+
+static FORCEINLINE FLuaArray* TArrayView_Guard(lua_State* L, FLuaArrayView*& OutView)
+{
+    const auto Array = TArrayView_Pin(L, 1, OutView);
+    if (!Array)
+        luaL_error(L, "invalid TArrayView, the viewed TArray was released");
+    TArray_Guard(L, Array);
+    return Array;
+}
+
+static void TArrayView_New(lua_State* L, int32 SourceIndex, FLuaArray::EElementKind Kind, int32 Offset, int32 Count)
+{
+    SourceIndex = lua_absindex(L, SourceIndex);
+    const auto Userdata = lua_newuserdata(L, sizeof(FLuaArrayView));
+    new(Userdata) FLuaArrayView(Kind, Offset, Count);
+    lua_pushvalue(L, SourceIndex);
+    lua_setuservalue(L, -2);
+    luaL_setmetatable(L, ARRAY_VIEW_METATABLE);
+}
+
+/**
+ * Test if the viewed array is still alive
+ */
+static int32 TArrayView_IsValid(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Pin(L, 1, View);
+    lua_pushboolean(L, Array && Array->Inner->IsValid());
+    return 1;
+}
+
+static int32 TArrayView_Length(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    lua_pushinteger(L, View->Num(*Array));
+    return 1;
+}
+
+static int32 TArrayView_Index(lua_State* L)
+{
+    if (!lua_isinteger(L, 2))
+    {
+        lua_getmetatable(L, 1);
+        lua_pushvalue(L, 2);
+        lua_rawget(L, -2);
+        return 1;
+    }
+
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Index = (int32)lua_tointeger(L, 2) - 1;
+    if (Index < 0 || Index >= View->Num(*Array))
+    {
+        UNLUA_LOGERROR(L, LogUnLua, Log, TEXT("%s: TArrayView Invalid Index!"), ANSI_TO_TCHAR(__FUNCTION__));
+        return 0;
+    }
+
+    return TArrayView_Visit(View, View->GetData(*Array), [L, Index](auto* Data)
+    {
+        TArrayView_Push(L, (typename TArrayViewValue<typename TRemovePointer<decltype(Data)>::Type>::Type)Data[Index]);
+        return 1;
+    });
+}
+
+static int32 TArrayView_NewIndex(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Index = (int32)lua_tointeger(L, 2) - 1;
+    if (Index < 0 || Index >= View->Num(*Array))
+    {
+        UNLUA_LOGERROR(L, LogUnLua, Log, TEXT("%s: TArrayView Invalid Index!"), ANSI_TO_TCHAR(__FUNCTION__));
+        return 0;
+    }
+
+    return TArrayView_Visit(View, View->GetData(*Array), [L, Index](auto* Data)
+    {
+        TArrayView_To(L, 3, Data[Index]);
+        return 0;
+    });
+}
+
+/**
+ * Create a view of elements [First, Last] of this view, 'Last' defaults to the last element
+ */
+static int32 TArrayView_Slice(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Num = View->Num(*Array);
+    const int32 First = (int32)luaL_checkinteger(L, 2);
+    const int32 Last = (int32)luaL_optinteger(L, 3, Num);
+    if (First < 1 || Last > Num || First > Last + 1)
+        return luaL_error(L, "invalid slice range [%d, %d] of %d elements", First, Last, Num);
+
+    lua_getuservalue(L, 1);
+    TArrayView_New(L, -1, View->Kind, View->Offset + First - 1, Last - First + 1);
+    return 1;
+}
+
+/**
+ * Set elements [First, Last] to 'Value', the whole view by default
+ */
+static int32 TArrayView_Fill(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Num = View->Num(*Array);
+    const int32 First = (int32)luaL_optinteger(L, 3, 1);
+    const int32 Last = (int32)luaL_optinteger(L, 4, Num);
+    if (First < 1 || Last > Num || First > Last + 1)
+        return luaL_error(L, "invalid fill range [%d, %d] of %d elements", First, Last, Num);
+
+    return TArrayView_Visit(View, View->GetData(*Array), [L, First, Last](auto* Data)
+    {
+        typename TRemovePointer<decltype(Data)>::Type Value;
+        TArrayView_To(L, 2, Value);
+        for (int32 i = First - 1; i < Last; ++i)
+            Data[i] = Value;
+        return 0;
+    });
+}
+
+static int32 TArrayView_Sum(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Num = View->Num(*Array);
+    return TArrayView_Visit(View, View->GetData(*Array), [L, Num](auto* Data)
+    {
+        typename TArrayViewValue<typename TRemovePointer<decltype(Data)>::Type>::Type Sum = 0;
+        for (int32 i = 0; i < Num; ++i)
+            Sum += Data[i];
+        TArrayView_Push(L, Sum);
+        return 1;
+    });
+}
+
+static int32 TArrayView_Min(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Num = View->Num(*Array);
+    if (Num == 0)
+        return 0;
+    return TArrayView_Visit(View, View->GetData(*Array), [L, Num](auto* Data)
+    {
+        auto Min = Data[0];
+        for (int32 i = 1; i < Num; ++i)
+            Min = FMath::Min(Min, Data[i]);
+        TArrayView_Push(L, (typename TArrayViewValue<decltype(Min)>::Type)Min);
+        return 1;
+    });
+}
+
+static int32 TArrayView_Max(lua_State* L)
+{
+    FLuaArrayView* View;
+    const auto Array = TArrayView_Guard(L, View);
+    const int32 Num = View->Num(*Array);
+    if (Num == 0)
+        return 0;
+    return TArrayView_Visit(View, View->GetData(*Array), [L, Num](auto* Data)
+    {
+        auto Max = Data[0];
+        for (int32 i = 1; i < Num; ++i)
+            Max = FMath::Max(Max, Data[i]);
+        TArrayView_Push(L, (typename TArrayViewValue<decltype(Max)>::Type)Max);
+        return 1;
+    });
+}
+
+static const luaL_Reg TArrayViewLib[] =
+{
+    {"IsValid", TArrayView_IsValid},
+    {"Length", TArrayView_Length},
+    {"Num", TArrayView_Length},
+    {"Slice", TArrayView_Slice},
+    {"Fill", TArrayView_Fill},
+    {"Sum", TArrayView_Sum},
+    {"Min", TArrayView_Min},
+    {"Max", TArrayView_Max},
+    {"__len", TArrayView_Length},
+    {"__index", TArrayView_Index},
+    {"__newindex", TArrayView_NewIndex},
+    {nullptr, nullptr}
+};
+
+/**
+ * Create a typed view over an array of int32/float/double/uint8 elements
+ */
+static int32 TArray_View(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams != 1)
+        return luaL_error(L, "invalid parameters");
+
+    FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
+    TArray_Guard(L, Array);
+
+    if (!FLuaArrayView::IsSupported(Array->ElementKind))
+        return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("TArrayView doesn't support element type:%s"), *Array->Inner->GetName())));
+
+    if (luaL_newmetatable(L, ARRAY_VIEW_METATABLE))
+        luaL_setfuncs(L, TArrayViewLib, 0);
+    lua_pop(L, 1);
+
+    TArrayView_New(L, 1, Array->ElementKind, 0, INDEX_NONE);
     return 1;
 }
 
@@ -585,6 +846,7 @@ static const luaL_Reg TArrayLib[] =
     {"Contains", TArray_Contains},
     {"Append", TArray_Append},
     {"ToTable", TArray_ToTable},
+    {"View", TArray_View},
     {"__gc", TArray_Delete},
     {"__call", TArray_New},
     {"__pairs", TArray_Pairs},
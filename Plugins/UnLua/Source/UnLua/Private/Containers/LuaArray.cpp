@@ -0,0 +1,263 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaArray.h"
+#include "ReflectionUtils/PropertyDesc.h"
+
+template <typename T>
+static FORCEINLINE void PushIntegers(lua_State* L, const T* Data, int32 Count)
+{
+    for (int32 i = 0; i < Count; ++i)
+    {
+        lua_pushinteger(L, (lua_Integer)Data[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+}
+
+template <typename T>
+static FORCEINLINE void PushNumbers(lua_State* L, const T* Data, int32 Count)
+{
+    for (int32 i = 0; i < Count; ++i)
+    {
+        lua_pushnumber(L, (lua_Number)Data[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+}
+
+template <typename T>
+static FORCEINLINE void ToIntegers(lua_State* L, int32 Index, T* Data, int32 Count)
+{
+    for (int32 i = 0; i < Count; ++i)
+    {
+        lua_rawgeti(L, Index, i + 1);
+        Data[i] = (T)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+    }
+}
+
+template <typename T>
+static FORCEINLINE void ToNumbers(lua_State* L, int32 Index, T* Data, int32 Count)
+{
+    for (int32 i = 0; i < Count; ++i)
+    {
+        lua_rawgeti(L, Index, i + 1);
+        Data[i] = (T)lua_tonumber(L, -1);
+        lua_pop(L, 1);
+    }
+}
+
+void FLuaArray::ToTable(lua_State* L)
+{
+    const int32 Count = Num();
+    lua_createtable(L, Count, 0);
+
+    switch (ElementKind)
+    {
+    case EElementKind::Int8:
+        PushIntegers(L, (const int8*)GetData(), Count);
+        break;
+    case EElementKind::Int16:
+        PushIntegers(L, (const int16*)GetData(), Count);
+        break;
+    case EElementKind::Int32:
+        PushIntegers(L, (const int32*)GetData(), Count);
+        break;
+    case EElementKind::Int64:
+        PushIntegers(L, (const int64*)GetData(), Count);
+        break;
+    case EElementKind::UInt8:
+        PushIntegers(L, (const uint8*)GetData(), Count);
+        break;
+    case EElementKind::UInt16:
+        PushIntegers(L, (const uint16*)GetData(), Count);
+        break;
+    case EElementKind::UInt32:
+        PushIntegers(L, (const uint32*)GetData(), Count);
+        break;
+    case EElementKind::UInt64:
+        PushIntegers(L, (const uint64*)GetData(), Count);
+        break;
+    case EElementKind::Float:
+        PushNumbers(L, (const float*)GetData(), Count);
+        break;
+    case EElementKind::Double:
+        PushNumbers(L, (const double*)GetData(), Count);
+        break;
+    case EElementKind::Bool:
+        {
+            const bool* Data = (const bool*)GetData();
+            for (int32 i = 0; i < Count; ++i)
+            {
+                lua_pushboolean(L, Data[i]);
+                lua_rawseti(L, -2, i + 1);
+            }
+            break;
+        }
+    case EElementKind::PODStruct:
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Inner->ReadValue(L, GetData(i), true);
+            lua_rawseti(L, -2, i + 1);
+        }
+        break;
+    default:
+        Inner->Initialize(ElementCache);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Get(i, ElementCache);
+            Inner->ReadValue(L, ElementCache, true);
+            lua_rawseti(L, -2, i + 1);
+        }
+        Inner->Destruct(ElementCache);
+        break;
+    }
+}
+
+bool FLuaArray::AppendTable(lua_State* L, int32 Index)
+{
+    if (ElementKind == EElementKind::Generic)
+        return false;
+
+    Index = lua_absindex(L, Index);
+    const int32 Count = (int32)lua_rawlen(L, Index);
+
+    // only sequences without holes, nils and other keys are skipped by the generic path
+    int32 NumKeys = 0;
+    lua_pushnil(L);
+    while (lua_next(L, Index) != 0)
+    {
+        lua_pop(L, 1);
+        if (!lua_isinteger(L, -1))
+        {
+            lua_pop(L, 1);
+            return false;
+        }
+        const lua_Integer Key = lua_tointeger(L, -1);
+        if (Key < 1 || Key > Count)
+        {
+            lua_pop(L, 1);
+            return false;
+        }
+        NumKeys++;
+    }
+    if (NumKeys != Count)
+        return false;
+    if (Count == 0)
+        return true;
+
+    if (ElementKind == EElementKind::PODStruct)
+    {
+        const int32 First = AddDefaulted(Count);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            lua_rawgeti(L, Index, i + 1);
+            Inner->WriteValue(L, GetData(First + i), -1, true);
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+
+    const int32 First = AddUninitialized(Count);
+    void* Data = GetData(First);
+    switch (ElementKind)
+    {
+    case EElementKind::Int8:
+        ToIntegers(L, Index, (int8*)Data, Count);
+        break;
+    case EElementKind::Int16:
+        ToIntegers(L, Index, (int16*)Data, Count);
+        break;
+    case EElementKind::Int32:
+        ToIntegers(L, Index, (int32*)Data, Count);
+        break;
+    case EElementKind::Int64:
+        ToIntegers(L, Index, (int64*)Data, Count);
+        break;
+    case EElementKind::UInt8:
+        ToIntegers(L, Index, (uint8*)Data, Count);
+        break;
+    case EElementKind::UInt16:
+        ToIntegers(L, Index, (uint16*)Data, Count);
+        break;
+    case EElementKind::UInt32:
+        ToIntegers(L, Index, (uint32*)Data, Count);
+        break;
+    case EElementKind::UInt64:
+        ToIntegers(L, Index, (uint64*)Data, Count);
+        break;
+    case EElementKind::Float:
+        ToNumbers(L, Index, (float*)Data, Count);
+        break;
+    case EElementKind::Double:
+        ToNumbers(L, Index, (double*)Data, Count);
+        break;
+    case EElementKind::Bool:
+        for (int32 i = 0; i < Count; ++i)
+        {
+            lua_rawgeti(L, Index, i + 1);
+            ((bool*)Data)[i] = lua_toboolean(L, -1) != 0;
+            lua_pop(L, 1);
+        }
+        break;
+    default:
+        checkNoEntry();
+    }
+    return true;
+}
+
+FLuaArray::EElementKind FLuaArray::GetElementKind(const UnLua::ITypeInterface* InInner)
+{
+    const FProperty* Property = InInner ? InInner->GetUProperty() : nullptr;
+    if (!Property || Property->ArrayDim != 1)
+        return EElementKind::Generic;
+
+    if (const auto EnumProperty = CastField<FEnumProperty>(Property))
+        Property = EnumProperty->GetUnderlyingProperty();
+
+    if (const auto BoolProperty = CastField<FBoolProperty>(Property))
+        return BoolProperty->IsNativeBool() ? EElementKind::Bool : EElementKind::Generic;
+
+    if (const auto StructProperty = CastField<FStructProperty>(Property))
+    {
+        const auto Struct = StructProperty->Struct;
+        return Struct && (Struct->StructFlags & STRUCT_IsPlainOldData) ? EElementKind::PODStruct : EElementKind::Generic;
+    }
+
+    switch (GetPropertyType(Property))
+    {
+    case CPT_Int8:
+        return EElementKind::Int8;
+    case CPT_Int16:
+        return EElementKind::Int16;
+    case CPT_Int:
+        return EElementKind::Int32;
+    case CPT_Int64:
+        return EElementKind::Int64;
+    case CPT_Byte:
+        return EElementKind::UInt8;
+    case CPT_UInt16:
+        return EElementKind::UInt16;
+    case CPT_UInt32:
+        return EElementKind::UInt32;
+    case CPT_UInt64:
+        return EElementKind::UInt64;
+    case CPT_Float:
+        return EElementKind::Float;
+    case CPT_Double:
+        return EElementKind::Double;
+    default:
+        return EElementKind::Generic;
+    }
+}
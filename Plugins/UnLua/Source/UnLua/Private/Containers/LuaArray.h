@@ -54,12 +54,33 @@ public:
         OwnedBySelf,    // 'ScriptArray' is owned by self, it'll be freed in destructor
     };
 
+    /**
+     * Element types converted from/to lua tables in bulk
+     */
+    enum class EElementKind : uint8
+    {
+        Generic,    // converted one by one through 'Inner'
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Float,
+        Double,
+        Bool,
+        PODStruct,  // plain old data structs like FVector, skips the element cache
+    };
+
     FLuaArray(const FScriptArray* InScriptArray, TSharedPtr<UnLua::ITypeInterface> InInnerInterface, EScriptArrayFlag Flag = OwnedByOther)
         : ScriptArray((FScriptArray*)InScriptArray), Inner(InInnerInterface), ElementCache(nullptr), ElementSize(Inner->GetSize()), ScriptArrayFlag(Flag)
     {
         // allocate cache for a single element
         ElementCache = FMemory::Malloc(ElementSize, Inner->GetAlignment());
         UNLUA_STAT_MEMORY_ALLOC(ElementCache, ContainerElementCache);
+        ElementKind = GetElementKind(Inner.Get());
     }
 
     ~FLuaArray()
@@ -382,11 +403,27 @@ public:
         return ScriptArray->GetData();
     }
 
+    /**
+     * Push a new lua table holding copies of all elements
+     */
+    void ToTable(lua_State* L);
+
+    /**
+     * Append elements of a lua sequence (t[1]...t[#t]) in bulk
+     *
+     * @param Index - stack index of the table
+     * @return - false if the table isn't a sequence or the element type isn't supported, nothing is appended then
+     */
+    bool AppendTable(lua_State* L, int32 Index);
+
+    static EElementKind GetElementKind(const UnLua::ITypeInterface* InInner);
+
     FScriptArray* ScriptArray;
     TSharedPtr<UnLua::ITypeInterface> Inner;
     void* ElementCache;            // can only hold one element...
     int32 ElementSize;
     EScriptArrayFlag ScriptArrayFlag;
+    EElementKind ElementKind;
 
 private:
     /**
@@ -416,4 +453,43 @@ private:
     }
 };
 
+/**
+ * Typed view over a numeric array, elements are read and written in place without lua tables or per element userdata.
+ * The view userdata pins the TArray userdata it was created from, and stops working once the dangling check releases it.
+ */
+class UNLUA_API FLuaArrayView
+{
+public:
+    FLuaArrayView(FLuaArray::EElementKind InKind, int32 InOffset, int32 InCount)
+        : Kind(InKind), Offset(InOffset), Count(InCount)
+    {
+    }
+
+    static FORCEINLINE bool IsSupported(FLuaArray::EElementKind Kind)
+    {
+        return Kind == FLuaArray::EElementKind::Int32
+            || Kind == FLuaArray::EElementKind::Float
+            || Kind == FLuaArray::EElementKind::Double
+            || Kind == FLuaArray::EElementKind::UInt8;
+    }
+
+    /**
+     * Get the number of elements visible through this view, the viewed array may have shrunk since the view was created
+     */
+    FORCEINLINE int32 Num(const FLuaArray& Array) const
+    {
+        const int32 Available = FMath::Max(Array.Num() - Offset, 0);
+        return Count == INDEX_NONE ? Available : FMath::Min(Count, Available);
+    }
+
+    FORCEINLINE void* GetData(FLuaArray& Array) const
+    {
+        return Array.GetData(Offset);
+    }
+
+    FLuaArray::EElementKind Kind;
+    int32 Offset;   // index of the first element in the viewed array
+    int32 Count;    // number of elements, INDEX_NONE for all elements up to the end
+};
+
 #undef ALIGNMENT_PLACEHOLDER
\ No newline at end of file
@@ -399,6 +399,22 @@ void* NewUserdataWithPadding(lua_State *L, int32 Size, const char *MetatableName
     return (uint8*)Userdata + PaddingSize;                          // return 'valid' address (userdata memory address + padding size)
 }
 
+/**
+ * Create a new userdata with padding size, the metatable is got by cached reference of the type
+ */
+void* NewUserdataWithPadding(lua_State *L, int32 Size, const UStruct *Type, uint8 PaddingSize)
+{
+    check(Size > 0 && (PaddingSize & 0x07) == 0);
+
+    void* Userdata = NewUserdataWithPaddingTag(L, Size, PaddingSize);
+    if (!UnLua::FLuaEnv::FindEnvChecked(L).GetClassRegistry()->TrySetMetatable(L, Type))
+    {
+        UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("%s, Invalid metatable, type: %s!"), ANSI_TO_TCHAR(__FUNCTION__), *Type->GetName());
+        return nullptr;
+    }
+    return (uint8*)Userdata + PaddingSize;
+}
+
 /**
  * Get a cpp instance's address
  */
@@ -453,7 +469,8 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
 
     // return null if container is already cached, or create/cache/return a new ud
     void *Userdata = nullptr;
-    lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
+    const auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
+    Env.PushRegistryTable(L, UnLua::ERegistryTable::ScriptContainerMap);
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);             
     if (Type == LUA_TNIL)
@@ -465,7 +482,7 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
         lua_pushlightuserdata(L, Key);
         lua_pushvalue(L, -2);
         lua_rawset(L, -4);                                  // cache it in 'ScriptContainerMap'
-        UnLua::FLuaEnv::FindEnv(L)->GetDanglingCheck()->CaptureContainer(L, Key);
+        Env.GetDanglingCheck()->CaptureContainer(L, Key);
     }
 #if UE_BUILD_DEBUG
     else
@@ -488,7 +505,8 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
 
     // return null if container is already cached, or create/cache/return a new ud
     void *Userdata = nullptr;
-    lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
+    const auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
+    Env.PushRegistryTable(L, UnLua::ERegistryTable::ScriptContainerMap);
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);
     if (Type == LUA_TNIL || !Validator(lua_touserdata(L, -1)))
@@ -500,7 +518,7 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
         lua_pushlightuserdata(L, Key);
         lua_pushvalue(L, -2);
         lua_rawset(L, -4);                                  // cache it in 'ScriptContainerMap'
-        UnLua::FLuaEnv::FindEnv(L)->GetDanglingCheck()->CaptureContainer(L, Key);
+        Env.GetDanglingCheck()->CaptureContainer(L, Key);
     }
 
     lua_remove(L, -2);
@@ -537,7 +555,7 @@ void RemoveCachedScriptContainer(lua_State *L, void *Key)
         return;
     }
 
-    lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
+    UnLua::FLuaEnv::FindEnvChecked(L).PushRegistryTable(L, UnLua::ERegistryTable::ScriptContainerMap);
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);
     if (Type != LUA_TNIL)
@@ -554,22 +572,37 @@ void RemoveCachedScriptContainer(lua_State *L, void *Key)
  */
 void PushObjectCore(lua_State *L, UObjectBaseUtility *Object)
 {
-    FString MetatableName = UnLua::LowLevel::GetMetatableName((UObject*)Object);
-    if (MetatableName.IsEmpty())
+    if (!Object)
     {
-		lua_pushnil(L);
-		return;
+        lua_pushnil(L);
+        return;
     }
-    
+
+    if (UNLIKELY(Object->IsA<UEnum>()))
+    {
+        const FString MetatableName = UnLua::LowLevel::GetMetatableName((UObject*)Object);
+        NewUserdataWithTwoLvPtrTag(L, sizeof(void*), Object);
+        if (!TryToSetMetatable(L, TCHAR_TO_UTF8(*MetatableName), (UObject*)Object))
+        {
+            UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("%s, Invalid metatable,Name %s, Object %s,%p!"), ANSI_TO_TCHAR(__FUNCTION__), *MetatableName, *Object->GetName(), Object);
+        }
+        return;
+    }
+
+    // the metatable is keyed by the struct itself for UStruct objects, otherwise by the object's class
+    const UStruct* Struct = Cast<UStruct>((UObject*)Object);
+    if (!Struct)
+        Struct = Object->GetClass();
+
 #if UNLUA_ENABLE_DEBUG != 0
-	UE_LOG(LogUnLua, Log, TEXT("%s : %p,%s,%s"), ANSI_TO_TCHAR(__FUNCTION__), Object,*Object->GetName(), *MetatableName);
+	UE_LOG(LogUnLua, Log, TEXT("%s : %p,%s,%s"), ANSI_TO_TCHAR(__FUNCTION__), Object,*Object->GetName(), *UnLua::LowLevel::GetMetatableName(Struct));
 #endif
 
     NewUserdataWithTwoLvPtrTag(L, sizeof(void*), Object);  // create a userdata and store the UObject address
-    bool bSuccess = TryToSetMetatable(L, TCHAR_TO_UTF8(*MetatableName), (UObject*)Object);
-	if (!bSuccess)
+    const auto Registry = UnLua::FLuaEnv::FindEnvChecked(L).GetClassRegistry();
+    if (!Registry->TrySetMetatable(L, Struct))
 	{
-        UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("%s, Invalid metatable,Name %s, Object %s,%p!"), ANSI_TO_TCHAR(__FUNCTION__), *MetatableName, *Object->GetName(), Object);
+        UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("%s, Invalid metatable,Name %s, Object %s,%p!"), ANSI_TO_TCHAR(__FUNCTION__), *UnLua::LowLevel::GetMetatableName(Struct), *Object->GetName(), Object);
     }
 }
 
@@ -728,7 +761,7 @@ static void PushPropertyArray(lua_State *L, T *Property, void *Value, void(*Push
         return;
     }
 
-    lua_getfield(L, LUA_REGISTRYINDEX, "ArrayMap");         // get weak table 'ArrayMap'
+    UnLua::FLuaEnv::FindEnvChecked(L).PushRegistryTable(L, UnLua::ERegistryTable::ArrayMap);   // get weak table 'ArrayMap'
     lua_pushlightuserdata(L, Value);
     int32 Type = lua_rawget(L, -2);
     if (Type != LUA_TTABLE)
@@ -857,7 +890,7 @@ bool GetObjectMapping(lua_State *L, UObjectBaseUtility *Object)
         return false;
     }
 
-    lua_getfield(L, LUA_REGISTRYINDEX, "UnLua_ObjectMap");
+    UnLua::FLuaEnv::FindEnvChecked(L).PushRegistryTable(L, UnLua::ERegistryTable::ObjectMap);
     lua_pushlightuserdata(L, Object);
     int32 Type = lua_rawget(L, -2);
     if (Type != LUA_TNIL)
@@ -942,6 +975,8 @@ bool PushFunction(lua_State *L, UObjectBaseUtility *Object, int32 FunctionRef)
 bool CallFunction(lua_State *L, int32 NumArgs, int32 NumResults)
 {
     int32 ErrorReporterIdx = lua_gettop(L) - NumArgs - 1;
+    const auto Env = UnLua::FLuaEnv::FindEnv(L);
+    const UnLua::FParamBufferArena::FGuard ArenaGuard(Env ? Env->GetParamBufferArena() : nullptr);
     int32 Code = lua_pcall(L, NumArgs, NumResults, -(NumArgs + 2));
     if (Code == LUA_OK)
     {
@@ -953,29 +988,225 @@ bool CallFunction(lua_State *L, int32 NumArgs, int32 NumResults)
     return false;
 }
 
+/**
+ * Property entry of metatables. It starts with the descriptor, so it's still a 'TSharedPtr' userdata,
+ * and primitives of native types are read and written with the offset and kind baked in.
+ * Exported properties of reflected classes are plain 'TSharedPtr' userdata in the same metatables,
+ * use FPropertyAccessor::Get to tell them apart.
+ */
+struct FPropertyAccessor
+{
+    static constexpr uint32 MagicNumber = 0x55504143; // 'UPAC'
+
+    enum class EKind : uint8
+    {
+        Generic,    // accessed by FPropertyDesc
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Float,
+        Double,
+        Bool,
+    };
+
+    TSharedPtr<FPropertyDesc> Property;
+    int32 Offset;
+    uint32 Magic;
+    EKind Kind;
+    bool bNativeOwner;
+
+    explicit FPropertyAccessor(const TSharedPtr<FPropertyDesc>& InProperty)
+        : Property(InProperty), Offset(0), Magic(MagicNumber), Kind(EKind::Generic), bNativeOwner(false)
+    {
+        const FProperty* UProperty = Property->GetProperty();
+        const UStruct* Owner = UProperty->GetOwnerStruct();
+        if (!Owner || !Owner->IsNative())
+            return; // offsets of blueprint properties change on recompiling
+
+        bNativeOwner = true;
+        Kind = GetKind(UProperty);
+        Offset = UProperty->GetOffset_ForInternal();
+    }
+
+    /**
+     * @return - nullptr if the userdata at Index is not an accessor
+     */
+    FORCEINLINE static FPropertyAccessor* Get(lua_State* L, int32 Index)
+    {
+        if (lua_rawlen(L, Index) != sizeof(FPropertyAccessor))
+            return nullptr;
+        const auto Accessor = static_cast<FPropertyAccessor*>(lua_touserdata(L, Index));
+        return Accessor && Accessor->Magic == MagicNumber ? Accessor : nullptr;
+    }
+
+    /** Properties of blueprint classes are gone after recompiling, while the flattened entries of child metatables remain */
+    FORCEINLINE bool IsStale() const
+    {
+        return !bNativeOwner && (!Property.IsValid() || !Property->IsValid());
+    }
+
+    static EKind GetKind(const FProperty* Property)
+    {
+        if (Property->ArrayDim != 1)
+            return EKind::Generic;
+
+        if (const auto EnumProperty = CastField<FEnumProperty>(Property))
+            return GetKind(EnumProperty->GetUnderlyingProperty());
+
+        if (const auto BoolProperty = CastField<FBoolProperty>(Property))
+            return BoolProperty->IsNativeBool() ? EKind::Bool : EKind::Generic;
+
+        switch (GetPropertyType(Property))
+        {
+        case CPT_Int8:
+            return EKind::Int8;
+        case CPT_Int16:
+            return EKind::Int16;
+        case CPT_Int:
+            return EKind::Int32;
+        case CPT_Int64:
+            return EKind::Int64;
+        case CPT_Byte:
+            return EKind::UInt8;
+        case CPT_UInt16:
+            return EKind::UInt16;
+        case CPT_UInt32:
+            return EKind::UInt32;
+        case CPT_UInt64:
+            return EKind::UInt64;
+        case CPT_Float:
+            return EKind::Float;
+        case CPT_Double:
+            return EKind::Double;
+        default:
+            return EKind::Generic;
+        }
+    }
+
+    FORCEINLINE void Read(lua_State* L, const void* ContainerPtr) const
+    {
+        const void* ValuePtr = (const uint8*)ContainerPtr + Offset;
+        switch (Kind)
+        {
+        case EKind::Int8:
+            lua_pushinteger(L, *(const int8*)ValuePtr);
+            break;
+        case EKind::Int16:
+            lua_pushinteger(L, *(const int16*)ValuePtr);
+            break;
+        case EKind::Int32:
+            lua_pushinteger(L, *(const int32*)ValuePtr);
+            break;
+        case EKind::Int64:
+            lua_pushinteger(L, *(const int64*)ValuePtr);
+            break;
+        case EKind::UInt8:
+            lua_pushinteger(L, *(const uint8*)ValuePtr);
+            break;
+        case EKind::UInt16:
+            lua_pushinteger(L, *(const uint16*)ValuePtr);
+            break;
+        case EKind::UInt32:
+            lua_pushinteger(L, *(const uint32*)ValuePtr);
+            break;
+        case EKind::UInt64:
+            lua_pushinteger(L, (lua_Integer)*(const uint64*)ValuePtr);
+            break;
+        case EKind::Float:
+            lua_pushnumber(L, *(const float*)ValuePtr);
+            break;
+        case EKind::Double:
+            lua_pushnumber(L, *(const double*)ValuePtr);
+            break;
+        case EKind::Bool:
+            lua_pushboolean(L, *(const bool*)ValuePtr);
+            break;
+        default:
+            Property->ReadValue_InContainer(L, ContainerPtr, false);
+        }
+    }
+
+    FORCEINLINE void Write(lua_State* L, void* ContainerPtr, int32 IndexInStack) const
+    {
+        void* ValuePtr = (uint8*)ContainerPtr + Offset;
+        switch (Kind)
+        {
+        case EKind::Int8:
+            *(int8*)ValuePtr = (int8)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::Int16:
+            *(int16*)ValuePtr = (int16)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::Int32:
+            *(int32*)ValuePtr = (int32)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::Int64:
+            *(int64*)ValuePtr = (int64)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::UInt8:
+            *(uint8*)ValuePtr = (uint8)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::UInt16:
+            *(uint16*)ValuePtr = (uint16)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::UInt32:
+            *(uint32*)ValuePtr = (uint32)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::UInt64:
+            *(uint64*)ValuePtr = (uint64)lua_tointeger(L, IndexInStack);
+            break;
+        case EKind::Float:
+            *(float*)ValuePtr = (float)lua_tonumber(L, IndexInStack);
+            break;
+        case EKind::Double:
+            *(double*)ValuePtr = (double)lua_tonumber(L, IndexInStack);
+            break;
+        case EKind::Bool:
+            *(bool*)ValuePtr = lua_toboolean(L, IndexInStack) != 0;
+            break;
+        default:
+            Property->WriteValue_InContainer(L, ContainerPtr, IndexInStack, true);
+        }
+    }
+};
+
 /**
  * Push a field (property or function)
  */
 static void PushField(lua_State *L, TSharedPtr<FFieldDesc> Field)
 {
-    const auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
+    auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
     check(Field && Field->IsValid());
     if (Field->IsProperty())
     {
-        TSharedPtr<FPropertyDesc> Property = Field->AsProperty();
-        Env.GetObjectRegistry()->Push(L, Property);
+        const auto Userdata = lua_newuserdata(L, sizeof(FPropertyAccessor));
+        luaL_getmetatable(L, "TSharedPtr");
+        lua_setmetatable(L, -2);
+        new(Userdata) FPropertyAccessor(Field->AsProperty());
     }
     else
     {
+        // raw pointers for the call path, the shared ptr only pins the descriptor as long as the closure lives
         TSharedPtr<FFunctionDesc> Function = Field->AsFunction();
+        lua_pushlightuserdata(L, Function.Get());
+        lua_pushlightuserdata(L, &Env);
         Env.GetObjectRegistry()->Push(L, Function);
         if (Function->IsLatentFunction())
         {
-            lua_pushcclosure(L, Class_CallLatentFunction, 1);   // closure
+            lua_pushcclosure(L, Class_CallLatentFunction, 3);   // closure
+        }
+        else if (Function->IsStaticFunction())
+        {
+            lua_pushcclosure(L, Class_CallStaticUFunction, 3);  // closure
         }
         else
         {
-            lua_pushcclosure(L, Class_CallUFunction, 1);        // closure
+            lua_pushcclosure(L, Class_CallUFunction, 3);        // closure
         }
     }
 }
@@ -999,53 +1230,11 @@ static void GetFieldInternal(lua_State* L)
     TSharedPtr<FFieldDesc> Field = ClassDesc->RegisterField(FieldName, ClassDesc);
     if (Field && Field->IsValid())
     {
-        bool bCached = false;
-        bool bInherited = Field->IsInherited();
-        if (bInherited)
-        {
-            FString SuperStructName = Field->GetOuterName();
-            const auto Pushed = Registry->PushMetatable(L, TCHAR_TO_UTF8(*SuperStructName));
-            check(Pushed);
-            lua_pushvalue(L, 2);
-            Type = lua_rawget(L, -2);
-            bCached = Type != LUA_TNIL;
-            // check cached property from non-native class
-            if (bCached && !Field->OuterClass->IsNative())
-            {
-                auto Ptr = lua_touserdata(L, -1);
-                if (Ptr)
-                {
-                    auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
-                    if (Property && Property->IsValid())
-                    {
-                        auto PropertyDesc = static_cast<FPropertyDesc*>((*Property).Get());
-                        if (!PropertyDesc->IsValid())
-                        {
-                            bCached = false;
-                        }
-                    }
-                }
-            }
-            if (!bCached)
-            {
-                lua_pop(L, 1);
-            }
-        }
-
-        if (!bCached)
-        {
-            PushField(L, Field);                // Property / closure
-            lua_pushvalue(L, 2);                // key
-            lua_pushvalue(L, -2);               // Property / closure
-            lua_rawset(L, -4);
-        }
-        if (bInherited)
-        {
-            lua_remove(L, -2);
-            lua_pushvalue(L, 2);                // key
-            lua_pushvalue(L, -2);               // Property / closure
-            lua_rawset(L, -4);
-        }
+        // inherited fields are flattened into this metatable, later lookups hit without visiting super metatables
+        PushField(L, Field);                    // Property / closure
+        lua_pushvalue(L, 2);                    // key
+        lua_pushvalue(L, -2);                   // Property / closure
+        lua_rawset(L, -4);
     }
     else
     {
@@ -1072,7 +1261,15 @@ FORCEINLINE static int32 GetField(lua_State* L)
     lua_pushvalue(L, 2);
     int32 Type = lua_rawget(L, -2);
     if (Type == LUA_TNIL)
+    {
         GetFieldInternal(L);
+    }
+    else if (Type == LUA_TUSERDATA)
+    {
+        const auto Accessor = FPropertyAccessor::Get(L, -1);
+        if (Accessor && Accessor->IsStale())
+            GetFieldInternal(L); // replace the stale entry
+    }
     lua_remove(L, -2);
     return 1;
 }
@@ -1209,8 +1406,29 @@ int32 Class_Index(lua_State *L)
     if (!Ptr)
         return 1;
 
-    auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
-    if (!Property->IsValid())
+    const auto Accessor = FPropertyAccessor::Get(L, -1);
+    if (!Accessor)
+    {
+        auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
+        if (!Property->IsValid())
+            return 0;
+
+        auto Self = GetCppInstance(L, 1);
+        if (!Self)
+            return 1;
+
+        if (UnLua::LowLevel::IsReleasedPtr(Self))
+            return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released object"), *(*Property)->GetName())));
+
+        if (!UnLua::LowLevel::CheckPropertyOwner(L, (*Property).Get(), Self))
+            return 0;
+
+        (*Property)->ReadValue_InContainer(L, Self, false);
+        lua_remove(L, -2);
+        return 1;
+    }
+
+    if (!Accessor->Property.IsValid())
         return 0;
     
     auto Self = GetCppInstance(L, 1);
@@ -1218,12 +1436,12 @@ int32 Class_Index(lua_State *L)
         return 1;
 
     if (UnLua::LowLevel::IsReleasedPtr(Self))
-        return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released object"), *(*Property)->GetName())));
+        return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released object"), *Accessor->Property->GetName())));
 
-    if (!UnLua::LowLevel::CheckPropertyOwner(L, (*Property).Get(), Self))
+    if (!UnLua::LowLevel::CheckPropertyOwner(L, Accessor->Property.Get(), Self))
         return 0;
 
-    (*Property)->ReadValue_InContainer(L, Self, false);
+    Accessor->Read(L, Self);
     lua_remove(L, -2);
     return 1;
 }
@@ -1236,7 +1454,7 @@ int32 Class_NewIndex(lua_State *L)
     GetField(L);
 
     auto Ptr = lua_touserdata(L, -1);
-    if (Ptr)
+    if (Ptr && !FPropertyAccessor::Get(L, -1))
     {
         auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
         if (Property->IsValid())
@@ -1254,6 +1472,24 @@ int32 Class_NewIndex(lua_State *L)
             }
         }
     }
+    else if (Ptr)
+    {
+        const auto Accessor = static_cast<FPropertyAccessor*>(Ptr);
+        if (Accessor->Property.IsValid())
+        {
+            void* Self = GetCppInstance(L, 1);
+            if (Self)
+            {
+                if (UnLua::LowLevel::IsReleasedPtr(Self))
+                    return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to write property '%s' on released object"), *Accessor->Property->GetName())));
+
+                if (!UnLua::LowLevel::CheckPropertyOwner(L, Accessor->Property.Get(), Self))
+                    return 0;
+
+                Accessor->Write(L, Self, 3);
+            }
+        }
+    }
     else
     {
         int32 Type = lua_type(L, 1);
@@ -1275,17 +1511,32 @@ int32 Class_NewIndex(lua_State *L)
  */
 int32 Class_CallUFunction(lua_State *L)
 {
-    //!!!Fix!!!
-    //delete desc when is not valid
-    auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
-    auto Function = Env.GetObjectRegistry()->Get<FFunctionDesc>(L, lua_upvalueindex(1));
+    const auto Function = (FFunctionDesc*)lua_touserdata(L, lua_upvalueindex(1));
+    if (!Function->IsValid())
+    {
+        UE_LOG(LogUnLua, Log, TEXT("%s: Invalid function descriptor!"), ANSI_TO_TCHAR(__FUNCTION__));
+        return 0;
+    }
+    auto& Env = *(UnLua::FLuaEnv*)lua_touserdata(L, lua_upvalueindex(2));
+    int32 NumParams = lua_gettop(L);
+    int32 NumResults = Function->CallUE(Env, L, NumParams);
+    return NumResults;
+}
+
+/**
+ * Generic closure to call a static UFunction
+ */
+int32 Class_CallStaticUFunction(lua_State *L)
+{
+    const auto Function = (FFunctionDesc*)lua_touserdata(L, lua_upvalueindex(1));
     if (!Function->IsValid())
     {
         UE_LOG(LogUnLua, Log, TEXT("%s: Invalid function descriptor!"), ANSI_TO_TCHAR(__FUNCTION__));
         return 0;
     }
+    auto& Env = *(UnLua::FLuaEnv*)lua_touserdata(L, lua_upvalueindex(2));
     int32 NumParams = lua_gettop(L);
-    int32 NumResults = Function->CallUE(L, NumParams);
+    int32 NumResults = Function->CallStaticUE(Env, L, NumParams);
     return NumResults;
 }
 
@@ -1294,14 +1545,14 @@ int32 Class_CallUFunction(lua_State *L)
  */
 int32 Class_CallLatentFunction(lua_State *L)
 {
-    auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
-    auto Function = Env.GetObjectRegistry()->Get<FFunctionDesc>(L, lua_upvalueindex(1));
-	if (!Function->IsValid())
+    const auto Function = (FFunctionDesc*)lua_touserdata(L, lua_upvalueindex(1));
+    if (!Function->IsValid())
     {
         UE_LOG(LogUnLua, Log, TEXT("%s: Invalid function descriptor!"), ANSI_TO_TCHAR(__FUNCTION__));
         return 0;
     }
 
+    auto& Env = *(UnLua::FLuaEnv*)lua_touserdata(L, lua_upvalueindex(2));
     auto ThreadRef = Env.FindOrAddThread(L);
     if (ThreadRef == LUA_REFNIL)
     {
@@ -1310,7 +1561,7 @@ int32 Class_CallLatentFunction(lua_State *L)
     }
 
     int32 NumParams = lua_gettop(L);
-    int32 NumResults = Function->CallUE(L, NumParams, &ThreadRef);
+    int32 NumResults = Function->CallUE(Env, L, NumParams, &ThreadRef);
     return lua_yield(L, NumResults);
 }
 
@@ -1388,16 +1639,31 @@ int32 ScriptStruct_Index(lua_State *L)
     if (lua_type(L, -1) != LUA_TUSERDATA)
         return 1;
 
-    const auto Registry = UnLua::FLuaEnv::FindEnvChecked(L).GetObjectRegistry();
-    const auto Property = Registry->Get<UnLua::ITypeOps>(L, -1);
-    if (!Property.IsValid())
+    const auto Accessor = FPropertyAccessor::Get(L, -1);
+    if (!Accessor)
+    {
+        const auto Registry = UnLua::FLuaEnv::FindEnvChecked(L).GetObjectRegistry();
+        const auto Property = Registry->Get<UnLua::ITypeOps>(L, -1);
+        if (!Property.IsValid())
+            return 0;
+
+        void* Self = GetCppInstanceFast(L, 1);
+        if (!Self)
+            return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released struct"), *Property->GetName())));
+
+        Property->ReadValue_InContainer(L, Self, false);
+        lua_remove(L, -2);
+        return 1;
+    }
+
+    if (!Accessor->Property.IsValid())
         return 0;
 
     void* Self = GetCppInstanceFast(L, 1);
     if (!Self)
-        return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released struct"), *Property->GetName())));
+        return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released struct"), *Accessor->Property->GetName())));
 
-    Property->ReadValue_InContainer(L, Self, false);
+    Accessor->Read(L, Self);
     lua_remove(L, -2);
     return 1;
 }
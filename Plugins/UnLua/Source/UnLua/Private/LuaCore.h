@@ -56,6 +56,7 @@ template <typename T> uint8 CalcUserdataPadding() { return CalcUserdataPadding(a
 UNLUA_API void* GetUserdata(lua_State *L, int32 Index, bool *OutTwoLvlPtr = nullptr, bool *OutClassMetatable = nullptr);
 UNLUA_API void* GetUserdataFast(lua_State *L, int32 Index, bool *OutTwoLvlPtr = nullptr);
 UNLUA_API void* NewUserdataWithPadding(lua_State *L, int32 Size, const char *MetatableName, uint8 PaddingSize = 0);
+UNLUA_API void* NewUserdataWithPadding(lua_State *L, int32 Size, const UStruct *Type, uint8 PaddingSize = 0);
 #define NewTypedUserdata(L, Type) NewUserdataWithPadding(L, sizeof(Type), #Type, CalcUserdataPadding<Type>())
 UNLUA_API void* GetCppInstance(lua_State *L, int32 Index);
 UNLUA_API void* GetCppInstanceFast(lua_State *L, int32 Index);
@@ -87,7 +88,7 @@ void PushStructArray(lua_State *L, FProperty *Property, void *Value, const char
 /**
  * Push a UObject to Lua stack
  */
-void PushObjectCore(lua_State *L, UObjectBaseUtility *Object);
+UNLUA_API void PushObjectCore(lua_State *L, UObjectBaseUtility *Object);
 
 /**
  * Get UObject and Lua function address for delegate
@@ -123,6 +124,7 @@ bool PeekTableElement(lua_State *L, void *Userdata);
 int32 Class_Index(lua_State* L);
 int32 Class_NewIndex(lua_State* L);
 int32 Class_CallUFunction(lua_State *L);
+int32 Class_CallStaticUFunction(lua_State *L);
 int32 Class_CallLatentFunction(lua_State *L);
 int32 Class_StaticClass(lua_State *L);
 int32 Class_Cast(lua_State* L);
@@ -21,21 +21,13 @@ namespace UnLua
 {
     bool FDanglingCheck::Enabled;
 
-    FDanglingCheck::FGuard::FGuard(FDanglingCheck* Owner)
-        : Owner(Owner)
+    void FDanglingCheck::ReleaseCaptured()
     {
-        Owner->GuardCount++;
-    }
-
-    FDanglingCheck::FGuard::~FGuard()
-    {
-        Owner->GuardCount--;
-
-        if (Owner->CapturedStructs.Num() > 0)
+        if (CapturedStructs.Num() > 0)
         {
-            const auto L = Owner->Env->GetMainState();
-            lua_getfield(L, LUA_REGISTRYINDEX, "StructMap");
-            for (const auto& StructPtr : Owner->CapturedStructs)
+            const auto L = Env->GetMainState();
+            Env->PushRegistryTable(L, ERegistryTable::StructMap);
+            for (const auto& StructPtr : CapturedStructs)
             {
                 lua_pushlightuserdata(L, StructPtr);
                 lua_rawget(L, -2);
@@ -58,15 +50,15 @@ namespace UnLua
                 lua_rawset(L, -3);
             }
             lua_pop(L, 1);
-            if (Owner->GuardCount == 0)
-                Owner->CapturedStructs.Empty();
+            if (GuardCount == 0)
+                CapturedStructs.Empty();
         }
 
-        if (Owner->CapturedContainers.Num() > 0)
+        if (CapturedContainers.Num() > 0)
         {
-            const auto L = Owner->Env->GetMainState();
-            lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
-            for (const auto& ContainerPtr : Owner->CapturedContainers)
+            const auto L = Env->GetMainState();
+            Env->PushRegistryTable(L, ERegistryTable::ScriptContainerMap);
+            for (const auto& ContainerPtr : CapturedContainers)
             {
                 lua_pushlightuserdata(L, ContainerPtr);
                 lua_rawget(L, -2);
@@ -88,8 +80,8 @@ namespace UnLua
                 lua_rawset(L, -3);
             }
             lua_pop(L, 1);
-            if (Owner->GuardCount == 0)
-                Owner->CapturedContainers.Empty();
+            if (GuardCount == 0)
+                CapturedContainers.Empty();
         }
     }
 
@@ -98,13 +90,6 @@ namespace UnLua
     {
     }
 
-    TUniquePtr<FDanglingCheck::FGuard> FDanglingCheck::MakeGuard()
-    {
-        if (!Enabled)
-            return TUniquePtr<FGuard>();
-        return MakeUnique<FGuard>(this);
-    }
-
     void FDanglingCheck::CaptureStruct(lua_State* L, void* Value)
     {
         if (!GuardCount)
@@ -26,26 +26,45 @@ namespace UnLua
     public:
         static bool Enabled;
 
+        /**
+         * Construct on stack around lua calls, does nothing if the check is disabled or compiled out
+         */
         class FGuard final
         {
         public:
-            explicit FGuard(FDanglingCheck* Owner);
+#if UNLUA_WITH_DANGLING_CHECK
+            explicit FGuard(FDanglingCheck* InOwner)
+                : Owner(Enabled ? InOwner : nullptr)
+            {
+                if (Owner)
+                    Owner->GuardCount++;
+            }
 
-            ~FGuard();
+            ~FGuard()
+            {
+                if (!Owner)
+                    return;
+                Owner->GuardCount--;
+                if (Owner->CapturedStructs.Num() > 0 || Owner->CapturedContainers.Num() > 0)
+                    Owner->ReleaseCaptured();
+            }
 
         private:
             FDanglingCheck* Owner;
+#else
+            explicit FGuard(FDanglingCheck* InOwner) {}
+#endif
         };
 
         explicit FDanglingCheck(FLuaEnv* Env);
 
-        TUniquePtr<FGuard> MakeGuard();
-
         void CaptureStruct(lua_State* L, void* Value);
 
         void CaptureContainer(lua_State* L, void* Value);
 
     private:
+        void ReleaseCaptured();
+
         FLuaEnv* Env;
         int32 GuardCount;
         TSet<void*> CapturedStructs;
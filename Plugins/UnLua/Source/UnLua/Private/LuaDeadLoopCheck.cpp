@@ -23,14 +23,11 @@ namespace UnLua
     FDeadLoopCheck::FDeadLoopCheck(FLuaEnv* Env)
         : Env(Env)
     {
+#if UNLUA_WITH_DEAD_LOOP_CHECK
         Runner = new FRunner();
-    }
-
-    TUniquePtr<FDeadLoopCheck::FGuard> FDeadLoopCheck::MakeGuard()
-    {
-        if (Timeout <= 0)
-            return TUniquePtr<FGuard>();
-        return MakeUnique<FGuard>(this);
+#else
+        Runner = nullptr;
+#endif
     }
 
     FDeadLoopCheck::FRunner::FRunner()
@@ -88,23 +85,14 @@ namespace UnLua
         GuardCounter.Decrement();
     }
 
-    FDeadLoopCheck::FGuard::FGuard(FDeadLoopCheck* Owner)
-        : Owner(Owner)
-    {
-        Owner->Runner->GuardEnter(this);
-    }
-
-    FDeadLoopCheck::FGuard::~FGuard()
-    {
-        Owner->Runner->GuardLeave();
-    }
-
     void FDeadLoopCheck::FGuard::SetTimeout()
     {
+#if UNLUA_WITH_DEAD_LOOP_CHECK
         const auto L = Owner->Env->GetMainState();
         const auto Hook = lua_gethook(L);
         if (Hook == nullptr)
             lua_sethook(L, OnLuaLineEvent, LUA_MASKLINE, 0);
+#endif
     }
 
     void FDeadLoopCheck::FGuard::OnLuaLineEvent(lua_State* L, lua_Debug* ar)
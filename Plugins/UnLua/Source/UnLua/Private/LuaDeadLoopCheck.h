@@ -28,19 +28,37 @@ namespace UnLua
     public:
         static int32 Timeout; // in seconds
         
+        /**
+         * Construct on stack around lua calls, does nothing if the check is disabled or compiled out
+         */
         class FGuard final
         {
         public:
-            explicit FGuard(FDeadLoopCheck* Owner);
-
-            ~FGuard();
+#if UNLUA_WITH_DEAD_LOOP_CHECK
+            explicit FGuard(FDeadLoopCheck* InOwner)
+                : Owner(Timeout > 0 ? InOwner : nullptr)
+            {
+                if (Owner)
+                    Owner->Runner->GuardEnter(this);
+            }
+
+            ~FGuard()
+            {
+                if (Owner)
+                    Owner->Runner->GuardLeave();
+            }
+#else
+            explicit FGuard(FDeadLoopCheck* InOwner) {}
+#endif
 
             void SetTimeout();
 
         private:
             static void OnLuaLineEvent(lua_State* L, lua_Debug* ar);
 
+#if UNLUA_WITH_DEAD_LOOP_CHECK
             FDeadLoopCheck* Owner;
+#endif
         };
 
         class FRunner final : public FRunnable
@@ -68,8 +86,6 @@ namespace UnLua
         
         explicit FDeadLoopCheck(FLuaEnv* Env);
 
-        TUniquePtr<FGuard> MakeGuard();
-
     private:
         FRunner* Runner;
         FLuaEnv* Env;
@@ -22,6 +22,8 @@ ULuaDelegateHandler::ULuaDelegateHandler()
     LuaRef = LUA_NOREF;
     Registry = nullptr;
     Delegate = nullptr;
+    FirstLink = INDEX_NONE;
+    bPoolable = true;
 }
 
 void ULuaDelegateHandler::Dummy()
@@ -58,6 +60,12 @@ void ULuaDelegateHandler::RemoveFrom(FMulticastDelegateProperty* InProperty, voi
     TMulticastDelegateTraits<FMulticastDelegateType>::RemoveDelegate(InProperty, MoveTemp(DynamicDelegate), nullptr, InDelegate);
 }
 
+bool ULuaDelegateHandler::IsAddedTo(FMulticastDelegateProperty* InProperty, void* InDelegate) const
+{
+    const auto ScriptDelegate = TMulticastDelegateTraits<FMulticastDelegateType>::GetMulticastDelegate(InProperty, InDelegate);
+    return ScriptDelegate && ScriptDelegate->Contains(this, NAME_Dummy);
+}
+
 void ULuaDelegateHandler::BeginDestroy()
 {
     if (Registry)
@@ -70,6 +78,7 @@ void ULuaDelegateHandler::Reset()
     LuaRef = LUA_NOREF;
     Registry = nullptr;
     Delegate = nullptr;
+    FirstLink = INDEX_NONE;
 }
 
 void ULuaDelegateHandler::ProcessEvent(UFunction* Function, void* Parms)
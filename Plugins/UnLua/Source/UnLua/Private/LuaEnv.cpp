@@ -76,6 +76,11 @@ namespace UnLua
 #endif
 
     FLuaEnv::FLuaEnv()
+        : FLuaEnv(GetDefault<UUnLuaSettings>()->bEnablePooledAllocator ? ELuaAllocator::Pooled : ELuaAllocator::Default)
+    {
+    }
+
+    FLuaEnv::FLuaEnv(const ELuaAllocator Allocator)
         : bStarted(false)
     {
         const auto Settings = GetDefault<UUnLuaSettings>();
@@ -84,27 +89,45 @@ namespace UnLua
 
         RegisterDelegates();
 
+        lua_Alloc AllocFunc = GetLuaAllocator();
+        void* AllocUserData = nullptr;
+        if (Allocator == ELuaAllocator::Pooled)
+        {
+            // pools sit on top of the env allocator, which may be customized by subclasses
+            PoolAllocator = new FLuaPoolAllocator(AllocFunc);
+            AllocFunc = FLuaPoolAllocator::Alloc;
+            AllocUserData = PoolAllocator;
+        }
+
 #if PLATFORM_WINDOWS
         // 防止类似AppleProResMedia插件忘了恢复Dll查找目录
         // https://github.com/Tencent/UnLua/issues/534
         const auto Dir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Binaries/Win64"));
         FPlatformProcess::PushDllDirectory(*Dir);
-        L = lua_newstate(GetLuaAllocator(), nullptr);
+        L = lua_newstate(AllocFunc, AllocUserData);
         FPlatformProcess::PopDllDirectory(*Dir);
 #else
-        L = lua_newstate(GetLuaAllocator(), nullptr);
+        L = lua_newstate(AllocFunc, AllocUserData);
 #endif
 
+        static_assert(LUA_EXTRASPACE >= sizeof(FLuaEnv*), "extra space of lua_State is too small to keep env pointer");
+        *static_cast<FLuaEnv**>(lua_getextraspace(L)) = this;
         AllEnvs.Add(L, this);
 
+        TouchedObjects = new FLuaTouchedObjects(this);
+
         luaL_openlibs(L);
 
+        FileSystemCache = new FLuaFileSystemCache(this);
+
         AddSearcher(LoadFromCustomLoader, 2);
         AddSearcher(LoadFromFileSystem, 3);
         AddSearcher(LoadFromBuiltinLibs, 4);
 
         UELib::Open(L);
 
+        CreateRegistryTables();
+
         ObjectRegistry = new FObjectRegistry(this);
         ClassRegistry = new FClassRegistry(this);
         ClassRegistry->Initialize();
@@ -118,18 +141,16 @@ namespace UnLua
 
         DanglingCheck = new FDanglingCheck(this);
         DeadLoopCheck = new FDeadLoopCheck(this);
+        GCScheduler = new FLuaGCScheduler(this);
+        GCScheduler->SetBudget(Settings->GCBudget);
+        GCScheduler->SetPolicy(Settings->GCPolicy);
+        NameCache = new FLuaNameCache(this);
+        ParamBufferArena = new FParamBufferArena(this);
+        ParamBufferArena->SetEnabled(Settings->bEnableParamBufferArena);
 
         AutoObjectReference.SetName("UnLua_AutoReference");
         ManualObjectReference.SetName("UnLua_ManualReference");
 
-        lua_pushstring(L, "StructMap"); // create weak table 'StructMap'
-        LowLevel::CreateWeakValueTable(L);
-        lua_rawset(L, LUA_REGISTRYINDEX);
-
-        lua_pushstring(L, "ArrayMap"); // create weak table 'ArrayMap'
-        LowLevel::CreateWeakValueTable(L);
-        lua_rawset(L, LUA_REGISTRYINDEX);
-
         if (FUnLuaDelegates::ConfigureLuaGC.IsBound())
         {
             FUnLuaDelegates::ConfigureLuaGC.Execute(L);
@@ -190,6 +211,12 @@ namespace UnLua
         delete PropertyRegistry;
         delete DanglingCheck;
         delete DeadLoopCheck;
+        delete FileSystemCache;
+        delete GCScheduler;
+        delete NameCache;
+        delete ParamBufferArena;
+        delete PoolAllocator;
+        delete TouchedObjects;
 
         if (!IsEngineExitRequested() && Manager)
         {
@@ -211,20 +238,6 @@ namespace UnLua
         return AllEnvs;
     }
 
-    FLuaEnv* FLuaEnv::FindEnv(const lua_State* L)
-    {
-        if (!L)
-            return nullptr;
-
-        const auto MainThread = G(L)->mainthread;
-        return AllEnvs.FindRef(MainThread);
-    }
-
-    FLuaEnv& FLuaEnv::FindEnvChecked(const lua_State* L)
-    {
-        return *AllEnvs.FindChecked(G(L)->mainthread);
-    }
-
     void FLuaEnv::Start(const TMap<FString, UObject*>& Args)
     {
         const auto& Setting = *GetDefault<UUnLuaSettings>();
@@ -242,7 +255,7 @@ namespace UnLua
             return;
         }
 
-        const auto Guard = GetDeadLoopCheck()->MakeGuard();
+        const FDeadLoopCheck::FGuard Guard(DeadLoopCheck);
         lua_pushcfunction(L, ReportLuaCallError);
         lua_getglobal(L, "require");
         lua_pushstring(L, TCHAR_TO_UTF8(*StartupModuleName));
@@ -252,8 +265,13 @@ namespace UnLua
             PushUObject(L, Pair.Value);
             lua_setfield(L, -2, TCHAR_TO_UTF8(*Pair.Key));
         }
-        lua_pcall(L, 2, LUA_MULTRET, -4);
+        {
+            const FParamBufferArena::FGuard ArenaGuard(ParamBufferArena);
+            lua_pcall(L, 2, LUA_MULTRET, -4);
+        }
         bStarted = true;
+
+        FileSystemCache->Report();
     }
 
     const FString& FLuaEnv::GetName()
@@ -268,14 +286,20 @@ namespace UnLua
 
     void FLuaEnv::NotifyUObjectDeleted(const UObjectBase* ObjectBase, int32 Index)
     {
+        // most deleted objects were never seen by lua
+        if (!TouchedObjects->TestAndClear(Index))
+            return;
+
         UObject* Object = (UObject*)ObjectBase;
         PropertyRegistry->NotifyUObjectDeleted(Object);
         FunctionRegistry->NotifyUObjectDeleted(Object);
         if (Manager)
             Manager->NotifyUObjectDeleted(Object);
         ObjectRegistry->NotifyUObjectDeleted(Object);
+        DelegateRegistry->NotifyUObjectDeleted(Object);
         ClassRegistry->NotifyUObjectDeleted(Object);
         EnumRegistry->NotifyUObjectDeleted(Object);
+        BindDecisions.Remove((UClass*)Object);
 
         if (CandidateInputComponents.Num() <= 0)
             return;
@@ -305,6 +329,7 @@ namespace UnLua
             return false;
 
         CandidateInputComponents.AddUnique((UInputComponent*)Object);
+        TouchedObjects->Mark(Object);
         if (OnWorldTickStartHandle.IsValid())
             FWorldDelegates::OnWorldTickStart.Remove(OnWorldTickStartHandle);
         OnWorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddRaw(this, &FLuaEnv::OnWorldTickStart);
@@ -346,39 +371,59 @@ namespace UnLua
             return false;
         }
 
-        static UClass* InterfaceClass = UUnLuaInterface::StaticClass();
-        const bool bImplUnluaInterface = Class->ImplementsInterface(InterfaceClass);
-
         if (IsInAsyncLoadingThread())
         {
             // avoid adding too many objects, affecting performance.
-            if (bImplUnluaInterface || (!bImplUnluaInterface && GLuaDynamicBinding.IsValid(Class)))
+            static UClass* InterfaceClass = UUnLuaInterface::StaticClass();
+            if (Class->ImplementsInterface(InterfaceClass) || GLuaDynamicBinding.IsValid(Class))
             {
                 // all bind operation should be in game thread, include dynamic bind
-                FScopeLock Lock(&CandidatesLock);
-                Candidates.AddUnique(Object);
-                return false;
+                AddCandidate(Object);
             }
+            return false;
         }
 
-        if (!bImplUnluaInterface)
+        // archetypes other than CDOs may give module names of their own, resolve them every time as before
+        const bool bArchetype = Object->HasAnyFlags(RF_ArchetypeObject) && !Object->HasAnyFlags(RF_ClassDefaultObject);
+        const bool bCacheEnabled = IsInGameThread() && !bArchetype;
+        FBindDecision* Decision = bCacheEnabled ? BindDecisions.Find(Class) : nullptr;
+        FBindDecision Uncached;
+        if (!Decision)
+        {
+            const bool bCacheable = ResolveBindDecision(Object, Class, Uncached);
+            if (bCacheEnabled && bCacheable)
+            {
+                Decision = &BindDecisions.Add(Class, Uncached);
+                TouchedObjects->Mark(Class);
+            }
+            else
+            {
+                Decision = &Uncached;
+            }
+        }
+
+        if (Decision->Kind == FBindDecision::EKind::Dynamic)
         {
-            // dynamic binding
             if (!GLuaDynamicBinding.IsValid(Class))
+            {
+                Decision->Rejects++;
                 return false;
+            }
 
+            Decision->Hits++;
             return GetManager()->Bind(Object, *GLuaDynamicBinding.ModuleName, GLuaDynamicBinding.InitializerTableRef);
         }
 
-        if (Class->GetName().Contains(TEXT("SKEL_")))
+        if (Decision->Kind == FBindDecision::EKind::Never)
+        {
+            Decision->Rejects++;
             return false;
+        }
 
-        if (!ensureMsgf(ModuleLocator, TEXT("Invalid lua module locator, lua binding will not work properly. please check unlua runtime settings.")))
-            return false;
+        Decision->Hits++;
 
-        const auto ModuleName = ModuleLocator->Locate(Object);
-        if (ModuleName.IsEmpty())
-            return false;
+        // binding may create objects and rehash the decisions
+        const FString ModuleName = Decision->ModuleName;
 
 #if !UE_BUILD_SHIPPING
         if (GLuaDynamicBinding.IsValid(Class) && GLuaDynamicBinding.ModuleName != ModuleName)
@@ -390,12 +435,50 @@ namespace UnLua
         return GetManager()->Bind(Object, *ModuleName, GLuaDynamicBinding.InitializerTableRef);
     }
 
+    void FLuaEnv::ResetBindDecisions()
+    {
+        BindDecisions.Empty();
+    }
+
+    bool FLuaEnv::ResolveBindDecision(UObject* Object, UClass* Class, FBindDecision& OutDecision) const
+    {
+        static UClass* InterfaceClass = UUnLuaInterface::StaticClass();
+        if (!Class->ImplementsInterface(InterfaceClass))
+        {
+            OutDecision.Kind = FBindDecision::EKind::Dynamic;
+            return true;
+        }
+
+        if (Class->GetName().Contains(TEXT("SKEL_")))
+        {
+            OutDecision.Kind = FBindDecision::EKind::Never;
+            return true;
+        }
+
+        if (!ensureMsgf(ModuleLocator, TEXT("Invalid lua module locator, lua binding will not work properly. please check unlua runtime settings.")))
+        {
+            OutDecision.Kind = FBindDecision::EKind::Never;
+            return false;
+        }
+
+        OutDecision.ModuleName = ModuleLocator->Locate(Object);
+        if (OutDecision.ModuleName.IsEmpty())
+        {
+            // CDO may be not initialized yet, try again next time
+            OutDecision.Kind = FBindDecision::EKind::Never;
+            return false;
+        }
+
+        OutDecision.Kind = FBindDecision::EKind::Static;
+        return true;
+    }
+
     bool FLuaEnv::DoString(const FString& Chunk, const FString& ChunkName)
     {
         const FTCHARToUTF8 ChunkUTF8(*Chunk);
         const FTCHARToUTF8 ChunkNameUTF8(*ChunkName);
-        const auto Guard = GetDeadLoopCheck()->MakeGuard();
-        const auto DanglingGuard = GetDanglingCheck()->MakeGuard();
+        const FDeadLoopCheck::FGuard Guard(DeadLoopCheck);
+        const FDanglingCheck::FGuard DanglingGuard(DanglingCheck);
         lua_pushcfunction(L, ReportLuaCallError);
         const auto MsgHandlerIdx = lua_gettop(L);
         if (!LoadBuffer(L, ChunkUTF8.Get(), ChunkUTF8.Length(), ChunkNameUTF8.Get()))
@@ -404,6 +487,7 @@ namespace UnLua
             return false;
         }
 
+        const FParamBufferArena::FGuard ArenaGuard(ParamBufferArena);
         const auto Result = lua_pcall(L, 0, LUA_MULTRET, MsgHandlerIdx);
         if (Result == LUA_OK)
         {
@@ -447,11 +531,19 @@ namespace UnLua
     {
         lua_gc(L, LUA_GCCOLLECT, 0);
         lua_gc(L, LUA_GCCOLLECT, 0);
+        GCScheduler->NotifyFullCollected();
     }
 
     void FLuaEnv::HotReload()
     {
+        FileSystemCache->Invalidate();
+        ResetBindDecisions();
+        if (ModuleLocator)
+            ModuleLocator->Invalidate();
         DoString("UnLua.HotReload()");
+        if (Manager)
+            Manager->ResetInitializeRefs();
+        ClassRegistry->ResetMetatableRefs();
     }
 
     int32 FLuaEnv::FindThread(const lua_State* Thread)
@@ -467,6 +559,7 @@ namespace UnLua
             return;
 
         lua_State* Thread = *ThreadPtr;
+        const FParamBufferArena::FGuard ArenaGuard(ParamBufferArena);
 #if 504 == LUA_VERSION_NUM
         int NResults = 0;
         int32 Status = lua_resume(Thread, L, 0, &NResults);
@@ -604,45 +697,23 @@ namespace UnLua
         FileName.ReplaceInline(TEXT("."), TEXT("/"));
 
         auto& Env = *(FLuaEnv*)lua_touserdata(L, lua_upvalueindex(1));
+        const auto Cache = Env.FileSystemCache;
         TArray<uint8> Data;
         FString FullPath;
-
-        auto LoadIt = [&]
-        {
-            if (Env.LoadString(L, Data, FullPath))
-                return 1;
-            const auto Msg = FString::Printf(TEXT("file loading from file system error.\nfull path:%s"), *FullPath);
-            return luaL_error(L, TCHAR_TO_UTF8(*Msg));
-        };
-
-        const auto PackagePath = UnLuaLib::GetPackagePath(L);
-        if (PackagePath.IsEmpty())
-            return 0;
-
-        TArray<FString> Patterns;
-        if (PackagePath.ParseIntoArray(Patterns, TEXT(";"), false) == 0)
+        if (!Cache->Read(L, FileName, Data, FullPath))
             return 0;
 
-        // 优先加载下载目录下的单文件
-        for (auto& Pattern : Patterns)
-        {
-            Pattern.ReplaceInline(TEXT("?"), *FileName);
-            const auto PathWithPersistentDir = FPaths::Combine(FPaths::ProjectPersistentDownloadDir(), Pattern);
-            FullPath = FPaths::ConvertRelativePathToFull(PathWithPersistentDir);
-            if (FFileHelper::LoadFileToArray(Data, *FullPath, FILEREAD_Silent))
-                return LoadIt();
-        }
+        if (Cache->LoadBytecode(L, Data, FullPath))
+            return 1;
 
-        // 其次是打包目录下的文件
-        for (auto& Pattern : Patterns)
+        if (Env.LoadString(L, Data, FullPath))
         {
-            const auto PathWithProjectDir = FPaths::Combine(FPaths::ProjectDir(), Pattern);
-            FullPath = FPaths::ConvertRelativePathToFull(PathWithProjectDir);
-            if (FFileHelper::LoadFileToArray(Data, *FullPath, FILEREAD_Silent))
-                return LoadIt();
+            Cache->SaveBytecode(L, Data, FullPath);
+            return 1;
         }
 
-        return 0;
+        const auto Msg = FString::Printf(TEXT("file loading from file system error.\nfull path:%s"), *FullPath);
+        return luaL_error(L, TCHAR_TO_UTF8(*Msg));
     }
 
     void FLuaEnv::AddSearcher(lua_CFunction Searcher, int Index) const
@@ -670,54 +741,78 @@ namespace UnLua
         lua_pop(L, 1);
     }
 
+    void FLuaEnv::CreateRegistryTables()
+    {
+        // keep the names in registry for compatibility, hot paths should use the pinned refs
+        static const char* Names[] = {"UnLua_ObjectMap", "StructMap", "ArrayMap", "ScriptContainerMap"};
+        static_assert(UE_ARRAY_COUNT(Names) == (int32)ERegistryTable::Num, "registry table names mismatch");
+
+        for (int32 i = 0; i < (int32)ERegistryTable::Num; i++)
+        {
+            LowLevel::CreateWeakValueTable(L);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, LUA_REGISTRYINDEX, Names[i]);
+            RegistryTableRefs[i] = luaL_ref(L, LUA_REGISTRYINDEX);
+        }
+    }
+
+    void FLuaEnv::AddCandidate(UObject* Object)
+    {
+        FScopeLock Lock(&CandidatesLock);
+        Candidates.Add(Object);
+        CandidateStats.Queued++;
+    }
+
     void FLuaEnv::OnAsyncLoadingFlushUpdate()
     {
-        TArray<FWeakObjectPtr> CandidatesTemp;
-        TArray<int> CandidatesRemovedIndexes;
+        {
+            // both buffers keep their capacity, loading threads never wait for the pass below
+            FScopeLock Lock(&CandidatesLock);
+            Swap(Candidates, IncomingCandidates);
+        }
+
+        if (IncomingCandidates.Num() == 0 && DeferredCandidates.Num() == 0)
+            return;
+
+        DeferredCandidates.Append(IncomingCandidates);
+        IncomingCandidates.Reset();
 
+        // single pass, objects still loading are compacted to the front in arrival order
         TArray<UObject*> LocalCandidates;
+        int32 NumDeferred = 0;
+        for (int32 i = 0; i < DeferredCandidates.Num(); ++i)
         {
+            UObject* Object = DeferredCandidates[i].Get();
+            if (!Object)
             {
-                FScopeLock Lock(&CandidatesLock);
-                CandidatesTemp.Append(Candidates);
+                // discard invalid objects
+                CandidateStats.Discarded++;
+                continue;
             }
 
-
-            for (int32 i = CandidatesTemp.Num() - 1; i >= 0; --i)
+            if (Object->HasAnyFlags(RF_NeedPostLoad)
+                || Object->HasAnyInternalFlags(AsyncObjectFlags)
+                || Object->GetClass()->HasAnyInternalFlags(AsyncObjectFlags))
             {
-                FWeakObjectPtr ObjectPtr = CandidatesTemp[i];
-                if (!ObjectPtr.IsValid())
-                {
-                    // discard invalid objects
-                    CandidatesRemovedIndexes.Add(i);
-                    continue;
-                }
-
-                UObject* Object = ObjectPtr.Get();
-                if (Object->HasAnyFlags(RF_NeedPostLoad)
-                    || Object->HasAnyInternalFlags(AsyncObjectFlags)
-                    || Object->GetClass()->HasAnyInternalFlags(AsyncObjectFlags))
-                {
-                    // delay bind on next update 
-                    continue;
-                }
-
-                LocalCandidates.Add(Object);
-                CandidatesRemovedIndexes.Add(i);
+                // delay bind on next update
+                DeferredCandidates[NumDeferred++] = DeferredCandidates[i];
+                continue;
             }
-        }
 
-        {
-            FScopeLock Lock(&CandidatesLock);
-            for (int32 j = 0; j < CandidatesRemovedIndexes.Num(); ++j)
-            {
-                Candidates.RemoveAt(CandidatesRemovedIndexes[j]);
-            }
+            LocalCandidates.Add(Object);
         }
+        DeferredCandidates.SetNum(NumDeferred, false);
 
+        CandidateStats.Deferred = NumDeferred;
+        CandidateStats.Processed += LocalCandidates.Num();
+        CandidateStats.MaxBatch = FMath::Max(CandidateStats.MaxBatch, LocalCandidates.Num());
+
+        // binding may flush async loading and get here again, candidates are all detached already
         for (int32 i = 0; i < LocalCandidates.Num(); ++i)
         {
             UObject* Object = LocalCandidates[i];
+            if (ObjectRegistry->IsBound(Object))
+                continue; // queued more than once
             TryBind(Object);
         }
     }
@@ -727,11 +822,17 @@ namespace UnLua
         OnAsyncLoadingFlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddRaw(this, &FLuaEnv::OnAsyncLoadingFlushUpdate);
         GUObjectArray.AddUObjectDeleteListener(this);
         bObjectArrayListenerRegistered = true;
+#if WITH_EDITOR
+        OnObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>&) { ResetBindDecisions(); });
+#endif
     }
 
     FORCEINLINE void FLuaEnv::UnRegisterDelegates()
     {
         FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(OnAsyncLoadingFlushUpdateHandle);
+#if WITH_EDITOR
+        FCoreUObjectDelegates::OnObjectsReplaced.Remove(OnObjectsReplacedHandle);
+#endif
         if (!bObjectArrayListenerRegistered)
             return;
         GUObjectArray.RemoveUObjectDeleteListener(this);
@@ -42,39 +42,62 @@ UnLua::FLuaEnv* ULuaEnvLocator_ByGameInstance::Locate(const UObject* Object)
     if (!Object)
         return GetDefault();
 
-    UGameInstance* GameInstance;
     if (Object->IsA(UGameInstance::StaticClass()))
+        return FindOrAdd((UGameInstance*)Object);
+
+    const auto Outer = Object->GetOuter();
+    if (!Outer)
+        return GetDefault();
+
+    const auto World = Outer->GetWorld();
+    if (!World)
+        return GetDefault();
+
+    // objects created in async loading or worker threads only read the cache
+    const bool bGameThread = IsInGameThread();
+    if (bGameThread)
     {
-        GameInstance = (UGameInstance*)Object;
+        // most objects are created in the same world one after another
+        if (LastWorld.Get() == World)
+            return LastEnv;
+
+        if (const auto Cached = WorldEnvs.Find(World))
+        {
+            LastWorld = World;
+            LastEnv = *Cached;
+            return LastEnv;
+        }
     }
     else
     {
-        const auto Outer = Object->GetOuter();
-        if (!Outer)
-            return GetDefault();
-
-        const auto World = Outer->GetWorld();
-        if (!World)
-            return GetDefault();
-
-        GameInstance = World->GetGameInstance();
-        if (!GameInstance)
-            return GetDefault();
+        FScopeLock Lock(&WorldEnvsLock);
+        if (const auto Cached = WorldEnvs.Find(World))
+            return *Cached;
     }
 
-    const auto Exists = Envs.Find(GameInstance);
-    if (Exists)
-        return (*Exists).Get();
+    // game instance may be set later, don't cache
+    const auto GameInstance = World->GetGameInstance();
+    if (!GameInstance)
+        return GetDefault();
 
-    const TSharedPtr<UnLua::FLuaEnv, ESPMode::ThreadSafe> Ret = MakeShared<UnLua::FLuaEnv, ESPMode::ThreadSafe>();
-    Ret->SetName(FString::Printf(TEXT("Env_%d"), Envs.Num() + 1));
-    Ret->Start();
-    Envs.Add(GameInstance, Ret);
-    return Ret.Get();
+    const auto Ret = FindOrAdd(GameInstance);
+    if (!bGameThread)
+        return Ret;
+
+    if (!OnWorldCleanupHandle.IsValid())
+        OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &ULuaEnvLocator_ByGameInstance::OnWorldCleanup);
+    {
+        FScopeLock Lock(&WorldEnvsLock);
+        WorldEnvs.Add(World, Ret);
+    }
+    LastWorld = World;
+    LastEnv = Ret;
+    return Ret;
 }
 
 void ULuaEnvLocator_ByGameInstance::HotReload()
 {
+    InvalidateWorlds();
     if (Env)
         Env->HotReload();
     for (const auto& Pair : Envs)
@@ -83,6 +106,9 @@ void ULuaEnvLocator_ByGameInstance::HotReload()
 
 void ULuaEnvLocator_ByGameInstance::Reset()
 {
+    InvalidateWorlds();
+    FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+    OnWorldCleanupHandle.Reset();
     Env.Reset();
     for (auto Pair : Envs)
         Pair.Value.Reset();
@@ -98,3 +124,37 @@ UnLua::FLuaEnv* ULuaEnvLocator_ByGameInstance::GetDefault()
     }
     return Env.Get();
 }
+
+UnLua::FLuaEnv* ULuaEnvLocator_ByGameInstance::FindOrAdd(UGameInstance* GameInstance)
+{
+    const auto Exists = Envs.Find(GameInstance);
+    if (Exists)
+        return (*Exists).Get();
+
+    const TSharedPtr<UnLua::FLuaEnv, ESPMode::ThreadSafe> Ret = MakeShared<UnLua::FLuaEnv, ESPMode::ThreadSafe>();
+    Ret->SetName(FString::Printf(TEXT("Env_%d"), Envs.Num() + 1));
+    Ret->Start();
+    Envs.Add(GameInstance, Ret);
+    return Ret.Get();
+}
+
+void ULuaEnvLocator_ByGameInstance::InvalidateWorlds()
+{
+    FScopeLock Lock(&WorldEnvsLock);
+    WorldEnvs.Empty();
+    LastWorld.Reset();
+    LastEnv = nullptr;
+}
+
+void ULuaEnvLocator_ByGameInstance::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    {
+        FScopeLock Lock(&WorldEnvsLock);
+        WorldEnvs.Remove(World);
+    }
+    if (LastWorld.Get() == World)
+    {
+        LastWorld.Reset();
+        LastEnv = nullptr;
+    }
+}
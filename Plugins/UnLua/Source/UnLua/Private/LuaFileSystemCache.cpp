@@ -0,0 +1,339 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaFileSystemCache.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "LuaEnv.h"
+#include "UnLuaLib.h"
+
+namespace UnLua
+{
+    bool FLuaFileSystemCache::BytecodeCacheEnabled;
+
+    static int WriteBytecode(lua_State* L, const void* Data, size_t Size, void* UD)
+    {
+        static_cast<TArray<uint8>*>(UD)->Append(static_cast<const uint8*>(Data), Size);
+        return 0;
+    }
+
+    static bool CompileChunk(const TArray<uint8>& Source, const FString& ChunkName, TArray<uint8>& OutBytecode)
+    {
+        // private state per call, safe in worker threads. chunks with utf-8 BOM fail here
+        // and are compiled by FLuaEnv::LoadBuffer as before.
+        const auto L = luaL_newstate();
+        if (!L)
+            return false;
+
+        bool bSucceed = luaL_loadbufferx(L, (const char*)Source.GetData(), Source.Num(), TCHAR_TO_UTF8(*ChunkName), "t") == LUA_OK;
+        if (bSucceed)
+        {
+#if LUA_VERSION_NUM >= 503
+            bSucceed = lua_dump(L, WriteBytecode, &OutBytecode, 0) == 0;
+#else
+            bSucceed = lua_dump(L, WriteBytecode, &OutBytecode) == 0;
+#endif
+        }
+        lua_close(L);
+
+        if (!bSucceed)
+            OutBytecode.Empty();
+        return bSucceed;
+    }
+
+    FLuaFileSystemCache::FLuaFileSystemCache(FLuaEnv* Env)
+        : Env(Env), bValid(false), bIndexed(false)
+    {
+    }
+
+    bool FLuaFileSystemCache::Read(lua_State* L, const FString& FileName, TArray<uint8>& OutData, FString& OutFullPath)
+    {
+        const auto CurrentPackagePath = UnLuaLib::GetPackagePath(L);
+        if (CurrentPackagePath.IsEmpty())
+            return false;
+
+        if (!bValid || !PackagePath.Equals(CurrentPackagePath, ESearchCase::CaseSensitive))
+            Rebuild(CurrentPackagePath);
+
+        if (Patterns.Num() == 0)
+            return false;
+
+        FPrefetchedChunk Chunk;
+        if (Prefetched.Num() > 0 && Prefetched.RemoveAndCopyValue(FileName, Chunk))
+        {
+            OutData = MoveTemp(Chunk.Source);
+            OutFullPath = MoveTemp(Chunk.FullPath);
+            PendingBytecode = MoveTemp(Chunk.Bytecode);
+            PendingChunkName = OutFullPath;
+            Stats.Loads++;
+            Stats.IndexHits++;
+            Stats.PrefetchHits++;
+            return true;
+        }
+
+        if (bIndexed)
+        {
+            if (const auto Entry = Index.Find(FileName))
+            {
+                Stats.Probes++;
+                if (FFileHelper::LoadFileToArray(OutData, *Entry->FullPath, FILEREAD_Silent))
+                {
+                    OutFullPath = Entry->FullPath;
+                    Stats.Loads++;
+                    Stats.IndexHits++;
+                    Stats.ProbesSaved += Entry->ProbeIndex;
+                    return true;
+                }
+
+                // removed after indexing
+                Index.Remove(FileName);
+            }
+        }
+
+        // the file may be added after indexing, fallback to probing every pattern
+        if (!Probe(FileName, OutData, OutFullPath))
+            return false;
+
+        Stats.Loads++;
+        return true;
+    }
+
+    bool FLuaFileSystemCache::LoadBytecode(lua_State* L, const TArray<uint8>& Source, const FString& ChunkName)
+    {
+        if (PendingBytecode.Num() > 0)
+        {
+            const auto Bytecode = MoveTemp(PendingBytecode);
+            PendingBytecode.Reset();
+            if (PendingChunkName == ChunkName)
+            {
+                if (luaL_loadbufferx(L, (const char*)Bytecode.GetData(), Bytecode.Num(), TCHAR_TO_UTF8(*ChunkName), "b") == LUA_OK)
+                {
+                    Stats.BytesSaved += Source.Num();
+                    return true;
+                }
+                lua_pop(L, 1);
+            }
+        }
+
+        if (!BytecodeCacheEnabled)
+            return false;
+
+        TArray<uint8> Bytecode;
+        if (!FFileHelper::LoadFileToArray(Bytecode, *GetBytecodePath(Source, ChunkName), FILEREAD_Silent))
+            return false;
+
+        if (luaL_loadbufferx(L, (const char*)Bytecode.GetData(), Bytecode.Num(), TCHAR_TO_UTF8(*ChunkName), "b") != LUA_OK)
+        {
+            // incompatible or broken, compile from source instead
+            lua_pop(L, 1);
+            return false;
+        }
+
+        Stats.BytecodeHits++;
+        Stats.BytesSaved += Source.Num();
+        return true;
+    }
+
+    void FLuaFileSystemCache::SaveBytecode(lua_State* L, const TArray<uint8>& Source, const FString& ChunkName)
+    {
+        if (!BytecodeCacheEnabled || !lua_isfunction(L, -1))
+            return;
+
+        TArray<uint8> Bytecode;
+#if LUA_VERSION_NUM >= 503
+        const int Code = lua_dump(L, WriteBytecode, &Bytecode, 0);
+#else
+        const int Code = lua_dump(L, WriteBytecode, &Bytecode);
+#endif
+        if (Code != 0 || Bytecode.Num() == 0)
+            return;
+
+        if (FFileHelper::SaveArrayToFile(Bytecode, *GetBytecodePath(Source, ChunkName)))
+            Stats.BytecodeWrites++;
+    }
+
+    int32 FLuaFileSystemCache::Prefetch(lua_State* L, const TArray<FString>& ModuleNames)
+    {
+        const auto CurrentPackagePath = UnLuaLib::GetPackagePath(L);
+        if (CurrentPackagePath.IsEmpty())
+            return 0;
+
+        if (!bValid || !PackagePath.Equals(CurrentPackagePath, ESearchCase::CaseSensitive))
+            Rebuild(CurrentPackagePath);
+
+        // only indexed modules, probing is left to the loading
+        if (!bIndexed)
+            return 0;
+
+        struct FTask
+        {
+            FString FileName;
+            FPrefetchedChunk Chunk;
+            bool bLoaded = false;
+        };
+
+        TArray<FTask> Tasks;
+        Tasks.Reserve(ModuleNames.Num());
+        for (const auto& ModuleName : ModuleNames)
+        {
+            auto FileName = ModuleName.Replace(TEXT("."), TEXT("/"));
+            if (Prefetched.Contains(FileName))
+                continue;
+
+            if (const auto Entry = Index.Find(FileName))
+            {
+                auto& Task = Tasks.AddDefaulted_GetRef();
+                Task.FileName = MoveTemp(FileName);
+                Task.Chunk.FullPath = Entry->FullPath;
+            }
+        }
+
+        ParallelFor(Tasks.Num(), [&Tasks](int32 TaskIndex)
+        {
+            auto& Task = Tasks[TaskIndex];
+            Task.bLoaded = FFileHelper::LoadFileToArray(Task.Chunk.Source, *Task.Chunk.FullPath, FILEREAD_Silent);
+            if (Task.bLoaded)
+                CompileChunk(Task.Chunk.Source, Task.Chunk.FullPath, Task.Chunk.Bytecode);
+        });
+
+        int32 Count = 0;
+        for (auto& Task : Tasks)
+        {
+            if (!Task.bLoaded)
+                continue;
+            Prefetched.Add(MoveTemp(Task.FileName), MoveTemp(Task.Chunk));
+            Count++;
+        }
+
+        Stats.Prefetched += Count;
+        return Count;
+    }
+
+    void FLuaFileSystemCache::ClearPrefetched()
+    {
+        Prefetched.Empty();
+        PendingBytecode.Empty();
+    }
+
+    void FLuaFileSystemCache::Invalidate()
+    {
+        bValid = false;
+    }
+
+    void FLuaFileSystemCache::Report() const
+    {
+        UE_LOG(LogUnLua, Log, TEXT("%s loaded %d modules from file system, %d resolved by index, %d probes issued, %d probes saved, %d bytecode hits, %d bytecode writes, %d prefetched, %d prefetch hits, %lld source bytes loaded without compiling."),
+               *Env->GetName(), Stats.Loads, Stats.IndexHits, Stats.Probes, Stats.ProbesSaved, Stats.BytecodeHits, Stats.BytecodeWrites, Stats.Prefetched, Stats.PrefetchHits, Stats.BytesSaved);
+    }
+
+    void FLuaFileSystemCache::Rebuild(const FString& InPackagePath)
+    {
+        PackagePath = InPackagePath;
+        Patterns.Reset();
+        Index.Reset();
+        ClearPrefetched();
+        PackagePath.ParseIntoArray(Patterns, TEXT(";"), false);
+        bValid = true;
+        bIndexed = Patterns.Num() > 0;
+
+        // same order as probing, download dir first
+        const FString Roots[] = {FPaths::ProjectPersistentDownloadDir(), FPaths::ProjectDir()};
+        int32 ProbeIndex = 0;
+        for (const auto& Root : Roots)
+        {
+            for (const auto& Pattern : Patterns)
+            {
+                const int32 CurrentProbeIndex = ProbeIndex++;
+                if (!bIndexed)
+                    break;
+
+                // only patterns like 'Dir/?.ext' can be indexed by scanning the directory
+                int32 WildcardIndex;
+                if (!Pattern.FindChar(TEXT('?'), WildcardIndex))
+                {
+                    bIndexed = false;
+                    break;
+                }
+
+                const auto Prefix = Pattern.Left(WildcardIndex);
+                const auto Suffix = Pattern.Mid(WildcardIndex + 1);
+                if (!Prefix.EndsWith(TEXT("/")) || Suffix.IsEmpty() || Suffix.Contains(TEXT("?")) || Suffix.Contains(TEXT("/")))
+                {
+                    bIndexed = false;
+                    break;
+                }
+
+                // './?.lua' or '../?.lua' would scan the whole project or beyond, leave them to probing
+                const auto Dir = FPaths::ConvertRelativePathToFull(FPaths::Combine(Root, Prefix));
+                const auto RootDir = FPaths::ConvertRelativePathToFull(Root);
+                if (Prefix.StartsWith(TEXT(".")) || Prefix.StartsWith(TEXT("/")) || Prefix.Contains(TEXT(":")) || Prefix.Contains(TEXT(".."))
+                    || !Dir.StartsWith(RootDir) || Dir.Len() <= RootDir.Len() + 1)
+                {
+                    bIndexed = false;
+                    break;
+                }
+
+                TArray<FString> Files;
+                IFileManager::Get().FindFilesRecursive(Files, *Dir, *(TEXT("*") + Suffix), true, false, false);
+                for (const auto& File : Files)
+                {
+                    if (!File.StartsWith(Dir))
+                        continue;
+
+                    auto Key = File.Mid(Dir.Len(), File.Len() - Dir.Len() - Suffix.Len());
+                    Key.RemoveFromStart(TEXT("/"));
+                    if (!Index.Contains(Key))
+                        Index.Add(Key, {File, CurrentProbeIndex});
+                }
+            }
+        }
+
+        if (!bIndexed)
+            Index.Empty();
+
+        UE_LOG(LogUnLua, Verbose, TEXT("%s package path index rebuilt, %d modules indexed."), *Env->GetName(), Index.Num());
+    }
+
+    bool FLuaFileSystemCache::Probe(const FString& FileName, TArray<uint8>& OutData, FString& OutFullPath)
+    {
+        // 优先加载下载目录下的单文件，其次是打包目录下的文件
+        const FString Roots[] = {FPaths::ProjectPersistentDownloadDir(), FPaths::ProjectDir()};
+        for (const auto& Root : Roots)
+        {
+            for (const auto& Pattern : Patterns)
+            {
+                const auto RelativePath = Pattern.Replace(TEXT("?"), *FileName);
+                OutFullPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(Root, RelativePath));
+                Stats.Probes++;
+                if (FFileHelper::LoadFileToArray(OutData, *OutFullPath, FILEREAD_Silent))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    FString FLuaFileSystemCache::GetBytecodePath(const TArray<uint8>& Source, const FString& ChunkName) const
+    {
+        // bytecode depends on lua version and chunk name as well as the source
+        const FTCHARToUTF8 Name(*ChunkName);
+        uint64 Hash = CityHash64(LUA_RELEASE, sizeof(LUA_RELEASE) - 1);
+        Hash = CityHash64WithSeed(Name.Get(), Name.Length(), Hash);
+        Hash = CityHash64WithSeed((const char*)Source.GetData(), Source.Num(), Hash);
+        return FPaths::ProjectSavedDir() / TEXT("UnLua/Bytecode") / FString::Printf(TEXT("%016llx.luac"), Hash);
+    }
+}
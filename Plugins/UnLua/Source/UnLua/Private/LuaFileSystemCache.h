@@ -0,0 +1,128 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Module path index and compiled chunk cache for loading lua files from file system
+     */
+    class UNLUA_API FLuaFileSystemCache
+    {
+    public:
+        static bool BytecodeCacheEnabled;
+
+        struct FStats
+        {
+            int32 Loads = 0;            // modules loaded from file system
+            int32 IndexHits = 0;        // modules resolved by path index
+            int32 Probes = 0;           // file reads issued
+            int32 ProbesSaved = 0;      // file reads skipped by path index
+            int32 BytecodeHits = 0;     // chunks loaded from bytecode cache
+            int32 BytecodeWrites = 0;   // chunks written to bytecode cache
+            int64 BytesSaved = 0;       // source bytes loaded without compiling
+            int32 Prefetched = 0;       // chunks compiled in worker threads
+            int32 PrefetchHits = 0;     // prefetched chunks consumed by loading
+        };
+
+        explicit FLuaFileSystemCache(FLuaEnv* Env);
+
+        /**
+         * Find and read the file of a module
+         *
+         * @param FileName - module name with '.' replaced by '/'
+         * @return - false if the module file is not found
+         */
+        bool Read(lua_State* L, const FString& FileName, TArray<uint8>& OutData, FString& OutFullPath);
+
+        /**
+         * Load compiled chunk of the source and push it on stack
+         *
+         * @return - false if bytecode cache is disabled or missed
+         */
+        bool LoadBytecode(lua_State* L, const TArray<uint8>& Source, const FString& ChunkName);
+
+        /**
+         * Save the compiled chunk on the top of stack to bytecode cache
+         */
+        void SaveBytecode(lua_State* L, const TArray<uint8>& Source, const FString& ChunkName);
+
+        /**
+         * Read and compile module files in worker threads, the chunks are consumed by following reads
+         *
+         * @param ModuleNames - names passed to require
+         * @return - number of modules prefetched
+         */
+        int32 Prefetch(lua_State* L, const TArray<FString>& ModuleNames);
+
+        /**
+         * Drop prefetched chunks not consumed yet
+         */
+        void ClearPrefetched();
+
+        /**
+         * Drop the path index, it will be rebuilt on next read
+         */
+        void Invalidate();
+
+        void Report() const;
+
+        FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+    private:
+        struct FIndexEntry
+        {
+            FString FullPath;
+            int32 ProbeIndex; // index in the probing sequence if not indexed
+        };
+
+        struct FPrefetchedChunk
+        {
+            FString FullPath;
+            TArray<uint8> Source;
+            TArray<uint8> Bytecode; // empty if failed to compile
+        };
+
+        // module names are file paths, 'foo' must not resolve to 'Foo.lua' on case sensitive file systems
+        template <typename ValueType>
+        struct FFileNameKeyFuncs : TDefaultMapHashableKeyFuncs<FString, ValueType, false>
+        {
+            static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        };
+
+        void Rebuild(const FString& InPackagePath);
+
+        bool Probe(const FString& FileName, TArray<uint8>& OutData, FString& OutFullPath);
+
+        FString GetBytecodePath(const TArray<uint8>& Source, const FString& ChunkName) const;
+
+        FLuaEnv* Env;
+        FString PackagePath;
+        TArray<FString> Patterns;
+        TMap<FString, FIndexEntry, FDefaultSetAllocator, FFileNameKeyFuncs<FIndexEntry>> Index;
+        TMap<FString, FPrefetchedChunk, FDefaultSetAllocator, FFileNameKeyFuncs<FPrefetchedChunk>> Prefetched;
+        TArray<uint8> PendingBytecode; // bytecode of the prefetched chunk just read
+        FString PendingChunkName;
+        bool bValid;
+        bool bIndexed;
+        FStats Stats;
+    };
+}
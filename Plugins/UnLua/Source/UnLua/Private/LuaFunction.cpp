@@ -26,6 +26,12 @@ static constexpr size_t ScriptMagicHeaderSize = sizeof ScriptMagicHeader;
 DEFINE_FUNCTION(ULuaFunction::execCallLua)
 {
     const auto LuaFunction = Cast<ULuaFunction>(Stack.CurrentNativeFunction);
+    if (const auto Binding = UnLua::FObjectRegistry::FindBinding(Context))
+    {
+        // 已绑定的对象直接使用绑定时的Lua环境
+        Binding->Env->GetFunctionRegistry()->Invoke(LuaFunction, Context, Binding->Ref, Stack, RESULT_PARAM);
+        return;
+    }
     const auto Env = IUnLuaModule::Get().GetEnv(Context);
     if (!Env)
     {
@@ -40,6 +46,11 @@ DEFINE_FUNCTION(ULuaFunction::execScriptCallLua)
     const auto LuaFunction = Get(Stack.CurrentNativeFunction);
     if (!LuaFunction)
         return;
+    if (const auto Binding = UnLua::FObjectRegistry::FindBinding(Context))
+    {
+        Binding->Env->GetFunctionRegistry()->Invoke(LuaFunction, Context, Binding->Ref, Stack, RESULT_PARAM);
+        return;
+    }
     const auto Env = IUnLuaModule::Get().GetEnv(Context);
     if (!Env)
     {
@@ -0,0 +1,223 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaGCScheduler.h"
+#include "LuaEnv.h"
+#include "UnLuaPrivate.h"
+#include "Misc/CoreDelegates.h"
+#include "lstate.h"
+#include "lgc.h"
+
+UNLUA_DECLARE_CYCLE_STAT("Lua GC", UnLua_GC);
+
+namespace UnLua
+{
+    static constexpr int32 DefaultStepSize = 64;   // in KB
+    static constexpr int32 MinStepSize = 4;
+    static constexpr int32 MaxStepSize = 16 * 1024;
+    static constexpr int32 MaxHeapGrowth = 2;      // same as default pause of lua
+
+    int32 FLuaGCScheduler::GenerationalAllocRate = 1024;
+
+    FLuaGCScheduler::FLuaGCScheduler(FLuaEnv* Env)
+        : Env(Env)
+    {
+        OnBeginFrameHandle = FCoreDelegates::OnBeginFrame.AddRaw(this, &FLuaGCScheduler::Tick);
+    }
+
+    FLuaGCScheduler::~FLuaGCScheduler()
+    {
+        FCoreDelegates::OnBeginFrame.Remove(OnBeginFrameHandle);
+    }
+
+    void FLuaGCScheduler::Tick()
+    {
+        const bool bEnabled = Budget > 0;
+        if (bEnabled != bActive)
+            SetActive(bEnabled);
+
+        if (!bActive)
+            return;
+
+        UNLUA_SCOPE_CYCLE_COUNTER(UnLua_GC);
+
+        const double Now = FPlatformTime::Seconds();
+        const double DeltaTime = FMath::Max(Now - LastTickTime, 0.001);
+        LastTickTime = Now;
+
+        // heap growth between frames, which is all allocations while the collector is stopped
+        const int32 HeapSize = GetHeapSize();
+        const float AllocRate = FMath::Max(HeapSize - LastHeapSize, 0) / DeltaTime;
+        Stats.AllocRate = FMath::Lerp(Stats.AllocRate, AllocRate, 0.1f);
+
+#if 504 == LUA_VERSION_NUM
+        bool bGenerational = Policy == ELuaGCPolicy::Generational;
+        if (Policy == ELuaGCPolicy::Adaptive)
+        {
+            // minor collections are cheap with few allocations, heavy allocations make major collections spike
+            if (Stats.bGenerational)
+                bGenerational = Stats.AllocRate <= GenerationalAllocRate;
+            else
+                bGenerational = Stats.AllocRate < GenerationalAllocRate / 2;
+        }
+        if (bGenerational != Stats.bGenerational)
+            SetGenerational(bGenerational);
+#endif
+
+        if (!Stats.bGenerational)
+            Step(Now + Budget / 1000000.0, HeapSize);
+
+        LastHeapSize = GetHeapSize();
+
+        const double FrameTime = (FPlatformTime::Seconds() - Now) * 1000000.0;
+        Stats.FrameTime = FrameTime;
+        Stats.MaxFrameTime = FMath::Max(Stats.MaxFrameTime, FrameTime);
+        Stats.TotalTime += FrameTime / 1000000.0;
+        Stats.Frames++;
+    }
+
+    void FLuaGCScheduler::Step(const double Deadline, const int32 HeapSize)
+    {
+        const auto L = Env->GetMainState();
+
+        // the budget can't keep up with allocations, finish this cycle to keep heap bounded
+        const bool bOverrun = HeapSize > CycleHeapSize * MaxHeapGrowth;
+        if (bOverrun)
+            Stats.Overruns++;
+
+        double StepTime;
+        bool bFinished;
+        do
+        {
+            const double StepStart = FPlatformTime::Seconds();
+            bFinished = lua_gc(L, LUA_GCSTEP, Stats.StepSize) != 0;
+            StepTime = FPlatformTime::Seconds() - StepStart;
+            Stats.Steps++;
+            if (bFinished)
+            {
+                Stats.Cycles++;
+                CycleHeapSize = GetHeapSize();
+                break;
+            }
+        } while (bOverrun || FPlatformTime::Seconds() + StepTime < Deadline);
+
+        // aim at 4 steps per frame, so the last step won't exceed the budget too much
+        const double TargetStepTime = Budget / 4000000.0;
+        if (StepTime > TargetStepTime)
+            Stats.StepSize = FMath::Max(Stats.StepSize / 2, MinStepSize);
+        else if (!bFinished && StepTime < TargetStepTime / 2)
+            Stats.StepSize = FMath::Min(Stats.StepSize * 2, MaxStepSize);
+    }
+
+    void FLuaGCScheduler::NotifyFullCollected()
+    {
+        if (!bActive)
+            return;
+
+        CycleHeapSize = LastHeapSize = GetHeapSize();
+    }
+
+    void FLuaGCScheduler::Report() const
+    {
+        UE_LOG(LogUnLua, Log, TEXT("Lua GC: budget=%dus policy=%d mode=%s frames=%d steps=%d cycles=%d overruns=%d switches=%d step=%dKB alloc=%.1fKB/s last=%.1fus max=%.1fus total=%.3fs"),
+               Budget, (int32)Policy, Stats.bGenerational ? TEXT("generational") : TEXT("incremental"), Stats.Frames, Stats.Steps, Stats.Cycles,
+               Stats.Overruns, Stats.ModeSwitches, Stats.StepSize, Stats.AllocRate, Stats.FrameTime, Stats.MaxFrameTime, Stats.TotalTime);
+    }
+
+    void FLuaGCScheduler::SetActive(const bool bInActive)
+    {
+        bActive = bInActive;
+        const auto L = Env->GetMainState();
+        if (!bActive)
+        {
+            RestoreConfig();
+            return;
+        }
+
+        SaveConfig();
+        LastTickTime = FPlatformTime::Seconds();
+        CycleHeapSize = LastHeapSize = GetHeapSize();
+        Stats.StepSize = DefaultStepSize;
+#if 504 == LUA_VERSION_NUM
+        Stats.bGenerational = Policy != ELuaGCPolicy::Incremental;
+        if (Stats.bGenerational)
+            lua_gc(L, LUA_GCGEN, 0, 0);
+        else
+            lua_gc(L, LUA_GCINC, 0, 0, 0);
+#endif
+        lua_gc(L, Stats.bGenerational ? LUA_GCRESTART : LUA_GCSTOP, 0);
+    }
+
+    void FLuaGCScheduler::SaveConfig()
+    {
+        const auto L = Env->GetMainState();
+        SavedConfig.bRunning = lua_gc(L, LUA_GCISRUNNING, 0) != 0;
+#if 504 == LUA_VERSION_NUM
+        // lua 5.4 has no api to query the parameters without changing them
+        const auto Global = G(L);
+        SavedConfig.bGenerational = Global->gckind == KGC_GEN;
+        SavedConfig.Pause = getgcparam(Global->gcpause);
+        SavedConfig.StepMul = getgcparam(Global->gcstepmul);
+        SavedConfig.StepSize = Global->gcstepsize;
+        SavedConfig.MinorMul = Global->genminormul;
+        SavedConfig.MajorMul = getgcparam(Global->genmajormul);
+#else
+        SavedConfig.Pause = lua_gc(L, LUA_GCSETPAUSE, 0);
+        lua_gc(L, LUA_GCSETPAUSE, SavedConfig.Pause);
+        SavedConfig.StepMul = lua_gc(L, LUA_GCSETSTEPMUL, 0);
+        lua_gc(L, LUA_GCSETSTEPMUL, SavedConfig.StepMul);
+#endif
+    }
+
+    void FLuaGCScheduler::RestoreConfig()
+    {
+        const auto L = Env->GetMainState();
+#if 504 == LUA_VERSION_NUM
+        lua_gc(L, LUA_GCINC, SavedConfig.Pause, SavedConfig.StepMul, SavedConfig.StepSize);
+        if (SavedConfig.bGenerational)
+            lua_gc(L, LUA_GCGEN, SavedConfig.MinorMul, SavedConfig.MajorMul);
+        Stats.bGenerational = SavedConfig.bGenerational;
+#else
+        lua_gc(L, LUA_GCSETPAUSE, SavedConfig.Pause);
+        lua_gc(L, LUA_GCSETSTEPMUL, SavedConfig.StepMul);
+#endif
+        lua_gc(L, SavedConfig.bRunning ? LUA_GCRESTART : LUA_GCSTOP, 0);
+    }
+
+    void FLuaGCScheduler::SetGenerational(const bool bGenerational)
+    {
+#if 504 == LUA_VERSION_NUM
+        const auto L = Env->GetMainState();
+        if (bGenerational)
+        {
+            lua_gc(L, LUA_GCGEN, 0, 0);
+            lua_gc(L, LUA_GCRESTART, 0);
+        }
+        else
+        {
+            lua_gc(L, LUA_GCINC, 0, 0, 0);
+            lua_gc(L, LUA_GCSTOP, 0);
+            CycleHeapSize = GetHeapSize();
+        }
+        Stats.bGenerational = bGenerational;
+        Stats.ModeSwitches++;
+#endif
+    }
+
+    int32 FLuaGCScheduler::GetHeapSize() const
+    {
+        return lua_gc(Env->GetMainState(), LUA_GCCOUNT, 0);
+    }
+}
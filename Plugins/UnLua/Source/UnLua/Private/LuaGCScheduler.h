@@ -0,0 +1,116 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+#include "UnLuaSettings.h"
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Step lua GC within a time budget on every frame, instead of leaving it to allocations
+     */
+    class UNLUA_API FLuaGCScheduler
+    {
+    public:
+        static int32 GenerationalAllocRate; // in KB per second, adaptive policy goes incremental above it
+
+        struct FStats
+        {
+            double FrameTime = 0;       // GC time of last frame in microseconds
+            double MaxFrameTime = 0;    // max GC time of a frame in microseconds
+            double TotalTime = 0;       // total GC time in seconds
+            int32 Frames = 0;           // frames stepped
+            int32 Steps = 0;            // incremental steps
+            int32 Cycles = 0;           // incremental cycles finished
+            int32 Overruns = 0;         // frames exceeding budget to keep heap bounded
+            int32 ModeSwitches = 0;     // switches between incremental and generational
+            int32 StepSize = 0;         // KB per step
+            float AllocRate = 0;        // KB per second
+            bool bGenerational = false;
+        };
+
+        explicit FLuaGCScheduler(FLuaEnv* Env);
+
+        ~FLuaGCScheduler();
+
+        /**
+         * Run GC steps within budget, called on the beginning of every frame
+         */
+        void Tick();
+
+        /**
+         * Reset heap baseline after a full collection
+         */
+        void NotifyFullCollected();
+
+        void Report() const;
+
+        /**
+         * Set time budget in microseconds, 0 to leave GC to lua. takes effect on next frame
+         */
+        FORCEINLINE void SetBudget(const int32 InBudget) { Budget = InBudget; }
+
+        FORCEINLINE int32 GetBudget() const { return Budget; }
+
+        FORCEINLINE void SetPolicy(const ELuaGCPolicy InPolicy) { Policy = InPolicy; }
+
+        FORCEINLINE ELuaGCPolicy GetPolicy() const { return Policy; }
+
+        FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+    private:
+        /**
+         * Collector config before activation, including those set by FUnLuaDelegates::ConfigureLuaGC
+         */
+        struct FCollectorConfig
+        {
+            bool bRunning = true;
+            bool bGenerational = false;
+            int32 Pause = 0;
+            int32 StepMul = 0;
+            int32 StepSize = 0;
+            int32 MinorMul = 0;
+            int32 MajorMul = 0;
+        };
+
+        void SaveConfig();
+
+        void RestoreConfig();
+
+        void SetActive(bool bInActive);
+
+        void SetGenerational(bool bGenerational);
+
+        void Step(double Deadline, int32 HeapSize);
+
+        int32 GetHeapSize() const;
+
+        FLuaEnv* Env;
+        FStats Stats;
+        FCollectorConfig SavedConfig;
+        int32 Budget = 0;
+        ELuaGCPolicy Policy = ELuaGCPolicy::Adaptive;
+        FDelegateHandle OnBeginFrameHandle;
+        double LastTickTime = 0;
+        int32 LastHeapSize = 0;
+        int32 CycleHeapSize = 0; // heap size when last cycle finished
+        bool bActive = false;
+    };
+}
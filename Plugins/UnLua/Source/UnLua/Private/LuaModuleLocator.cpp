@@ -18,39 +18,92 @@
 FString ULuaModuleLocator::Locate(const UObject* Object)
 {
     const UObject* CDO;
+    const UClass* Class = nullptr; // cache key, archetypes may give different names than their class
     if (Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
     {
         CDO = Object;
+        if (Object->HasAnyFlags(RF_ClassDefaultObject))
+            Class = Object->GetClass();
     }
     else
     {
-        const auto Class = Cast<UClass>(Object);
-        CDO = Class ? Class->GetDefaultObject() : Object->GetClass()->GetDefaultObject();
+        const auto AsClass = Cast<UClass>(Object);
+        Class = AsClass ? AsClass : Object->GetClass();
+        CDO = Class->GetDefaultObject();
     }
 
+    FString ModuleName;
+    if (Class && FindCached(Class, ModuleName))
+        return ModuleName;
+
     if (CDO->HasAnyFlags(RF_NeedInitialization))
     {
         // CDO还没有初始化完成
         return "";
     }
 
-    if (!CDO->GetClass()->ImplementsInterface(UUnLuaInterface::StaticClass()))
+    if (CDO->GetClass()->ImplementsInterface(UUnLuaInterface::StaticClass()))
+        ModuleName = IUnLuaInterface::Execute_GetModuleName(CDO);
+
+    if (Class)
+        AddCached(Class, ModuleName);
+    return ModuleName;
+}
+
+void ULuaModuleLocator::Invalidate()
+{
+    FScopeLock Lock(&CacheLock);
+    Cache.Empty();
+}
+
+bool ULuaModuleLocator::FindCached(const UClass* Class, FString& OutModuleName) const
+{
+    // only game thread writes the cache
+    if (!IsInGameThread())
     {
-        return "";
+        FScopeLock Lock(&CacheLock);
+        return FindCachedUnsafe(Class, OutModuleName);
     }
+    return FindCachedUnsafe(Class, OutModuleName);
+}
+
+bool ULuaModuleLocator::FindCachedUnsafe(const UClass* Class, FString& OutModuleName) const
+{
+    const auto Cached = Cache.Find(Class);
+    if (!Cached)
+        return false;
+    OutModuleName = *Cached;
+    return true;
+}
+
+void ULuaModuleLocator::AddCached(const UClass* Class, const FString& ModuleName)
+{
+    if (!IsInGameThread())
+        return;
 
-    return IUnLuaInterface::Execute_GetModuleName(CDO);
+#if WITH_EDITOR
+    if (!OnObjectsReplacedHandle.IsValid())
+        OnObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(this, &ULuaModuleLocator::OnObjectsReplaced);
+#endif
+    FScopeLock Lock(&CacheLock);
+    Cache.Add(Class, ModuleName);
 }
 
+#if WITH_EDITOR
+void ULuaModuleLocator::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+    // recompiled blueprints keep their classes but may return different module names
+    Invalidate();
+}
+#endif
+
 FString ULuaModuleLocator_ByPackage::Locate(const UObject* Object)
 {
     const auto Class = Object->IsA<UClass>() ? static_cast<const UClass*>(Object) : Object->GetClass();
-    const auto Key = Class->GetFName();
-    const auto Cached = Cache.Find(Key);
-    if (Cached)
-        return *Cached;
-
     FString ModuleName;
+    if (FindCached(Class, ModuleName))
+        return ModuleName;
+
     if (Class->IsNative())
     {
         ModuleName = Class->GetName();
@@ -61,6 +114,6 @@ FString ULuaModuleLocator_ByPackage::Locate(const UObject* Object)
         const auto ChopCount = ModuleName.Find(TEXT("/"), ESearchCase::IgnoreCase, ESearchDir::FromStart, 1) + 1;
         ModuleName = ModuleName.Replace(TEXT("/"), TEXT(".")).RightChop(ChopCount);
     }
-    Cache.Add(Key, ModuleName);
+    AddCached(Class, ModuleName);
     return ModuleName;
 }
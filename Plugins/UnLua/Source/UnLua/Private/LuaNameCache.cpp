@@ -0,0 +1,218 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaNameCache.h"
+#include "LuaEnv.h"
+#include "UnLuaBase.h"
+
+namespace UnLua
+{
+    int32 FLuaNameCache::MaxEntries = 4096;
+
+    FLuaNameCache::FLuaNameCache(FLuaEnv* Env)
+        : Env(Env)
+    {
+        const auto L = Env->GetMainState();
+        lua_newtable(L);
+        TableRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    void FLuaNameCache::Push(lua_State* L, const FName& Name)
+    {
+        if (const auto Slot = NameToSlot.Find(Name))
+        {
+            Stats.PushHits++;
+            PushSlot(L, *Slot);
+            return;
+        }
+
+        Stats.PushMisses++;
+        const FTCHARToUTF8 Chars(*Name.ToString());
+        lua_pushlstring(L, Chars.Get(), Chars.Length());
+        if (Chars.Length() > MaxLength)
+            return;
+
+        const auto Slot = Anchor(L, -1);
+        auto& Entry = Entries[Slot - 1];
+        Entry.Name = Name;
+        Entry.bName = true;
+        NameToSlot.Add(Name, Slot);
+        CharsToName.Add(Entry.Chars, Slot);
+    }
+
+    void FLuaNameCache::Push(lua_State* L, const FString& String)
+    {
+        if (const auto Slot = StringToSlot.Find(String))
+        {
+            Stats.PushHits++;
+            PushSlot(L, *Slot);
+            return;
+        }
+
+        Stats.PushMisses++;
+        const FTCHARToUTF8 Chars(*String);
+        lua_pushlstring(L, Chars.Get(), Chars.Length());
+        if (Chars.Length() > MaxLength)
+            return;
+
+        const auto Slot = Anchor(L, -1);
+        auto& Entry = Entries[Slot - 1];
+        Entry.String = String;
+        StringToSlot.Add(String, Slot);
+        CharsToString.Add(Entry.Chars, Slot);
+    }
+
+    FName FLuaNameCache::ToName(lua_State* L, int32 Index)
+    {
+        size_t Len;
+        const auto Chars = lua_tolstring(L, Index, &Len);
+        if (!Chars)
+            return NAME_None;
+
+        if (const auto Slot = CharsToName.Find(Chars))
+        {
+            Stats.ReadHits++;
+            auto& Entry = Entries[*Slot - 1];
+            Entry.bReferenced = true;
+            return Entry.Name;
+        }
+
+        Stats.ReadMisses++;
+        const FName Name(UTF8_TO_TCHAR(Chars));
+        if (Len > MaxLength)
+            return Name;
+
+        const auto Slot = Anchor(L, Index);
+        auto& Entry = Entries[Slot - 1];
+        Entry.Name = Name;
+        Entry.bName = true;
+        CharsToName.Add(Chars, Slot);
+
+        // names keep the casing of first registration, only reuse the string when it is what the name prints
+        const auto NameString = Name.ToString();
+        if (FCStringAnsi::Strcmp(TCHAR_TO_UTF8(*NameString), Chars) == 0)
+            NameToSlot.Add(Name, Slot);
+        return Name;
+    }
+
+    FString FLuaNameCache::ToString(lua_State* L, int32 Index)
+    {
+        size_t Len;
+        const auto Chars = lua_tolstring(L, Index, &Len);
+        if (!Chars)
+            return FString();
+
+        if (const auto Slot = CharsToString.Find(Chars))
+        {
+            Stats.ReadHits++;
+            auto& Entry = Entries[*Slot - 1];
+            Entry.bReferenced = true;
+            return Entry.String;
+        }
+
+        Stats.ReadMisses++;
+        FString String = UTF8_TO_TCHAR(Chars);
+        if (Len > MaxLength)
+            return String;
+
+        const auto Slot = Anchor(L, Index);
+        Entries[Slot - 1].String = String;
+        CharsToString.Add(Chars, Slot);
+        StringToSlot.Add(String, Slot);
+        return String;
+    }
+
+    void FLuaNameCache::Flush()
+    {
+        const auto L = Env->GetMainState();
+        luaL_unref(L, LUA_REGISTRYINDEX, TableRef);
+        lua_newtable(L);
+        TableRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+        Entries.Reset();
+        ClockHand = 0;
+        NameToSlot.Reset();
+        StringToSlot.Reset();
+        CharsToName.Reset();
+        CharsToString.Reset();
+        Stats.Entries = 0;
+    }
+
+    void FLuaNameCache::Report() const
+    {
+        UE_LOG(LogUnLua, Log, TEXT("%s name cache: %d entries, %d push hits, %d push misses, %d read hits, %d read misses, %d evictions."),
+               *Env->GetName(), Stats.Entries, Stats.PushHits, Stats.PushMisses, Stats.ReadHits, Stats.ReadMisses, Stats.Evictions);
+    }
+
+    int32 FLuaNameCache::Anchor(lua_State* L, int32 Index)
+    {
+        int32 Slot;
+        if (Entries.Num() < FMath::Max(MaxEntries, 1))
+        {
+            Entries.AddDefaulted();
+            Slot = Entries.Num();
+            Stats.Entries = Entries.Num();
+        }
+        else
+        {
+            // give entries hit since last pass a second chance, the anchored string of the victim is released by overwriting its slot
+            while (Entries[ClockHand].bReferenced)
+            {
+                Entries[ClockHand].bReferenced = false;
+                ClockHand = (ClockHand + 1) % Entries.Num();
+            }
+            Slot = ClockHand + 1;
+            ClockHand = (ClockHand + 1) % Entries.Num();
+            Evict(Slot);
+            Stats.Evictions++;
+        }
+
+        Index = lua_absindex(L, Index);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, TableRef);
+        lua_pushvalue(L, Index);
+        lua_rawseti(L, -2, Slot);
+        lua_pop(L, 1);
+        Entries[Slot - 1].Chars = lua_tostring(L, Index);
+        return Slot;
+    }
+
+    void FLuaNameCache::Evict(int32 Slot)
+    {
+        auto& Entry = Entries[Slot - 1];
+        if (Entry.bName)
+        {
+            if (NameToSlot.FindRef(Entry.Name) == Slot)
+                NameToSlot.Remove(Entry.Name);
+            if (CharsToName.FindRef(Entry.Chars) == Slot)
+                CharsToName.Remove(Entry.Chars);
+        }
+        else
+        {
+            if (StringToSlot.FindRef(Entry.String) == Slot)
+                StringToSlot.Remove(Entry.String);
+            if (CharsToString.FindRef(Entry.Chars) == Slot)
+                CharsToString.Remove(Entry.Chars);
+        }
+        Entry = FEntry();
+    }
+
+    void FLuaNameCache::PushSlot(lua_State* L, int32 Slot)
+    {
+        Entries[Slot - 1].bReferenced = true;
+        lua_rawgeti(L, LUA_REGISTRYINDEX, TableRef);
+        lua_rawgeti(L, -1, Slot);
+        lua_remove(L, -2);
+    }
+}
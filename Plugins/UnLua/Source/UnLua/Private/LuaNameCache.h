@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Bidirectional cache between FName/FString values and lua strings anchored in registry,
+     * so reading and writing the same names skips UTF8 conversions and name table lookups
+     */
+    class UNLUA_API FLuaNameCache
+    {
+    public:
+        static int32 MaxEntries; // anchored lua strings before least recently used ones are evicted
+
+        static constexpr int32 MaxLength = 40; // only short strings are interned by lua
+
+        struct FStats
+        {
+            int32 PushHits = 0;     // values pushed from cache
+            int32 PushMisses = 0;   // values converted and pushed
+            int32 ReadHits = 0;     // lua strings read from cache
+            int32 ReadMisses = 0;   // lua strings converted
+            int32 Evictions = 0;    // entries evicted on reaching MaxEntries
+            int32 Entries = 0;      // anchored lua strings
+        };
+
+        explicit FLuaNameCache(FLuaEnv* Env);
+
+        void Push(lua_State* L, const FName& Name);
+
+        void Push(lua_State* L, const FString& String);
+
+        FName ToName(lua_State* L, int32 Index);
+
+        FString ToString(lua_State* L, int32 Index);
+
+        /**
+         * Drop all cached entries and release the anchored lua strings
+         */
+        void Flush();
+
+        void Report() const;
+
+        FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+    private:
+        struct FNameKeyFuncs : TDefaultMapHashableKeyFuncs<FName, int32, false>
+        {
+            static FORCEINLINE bool Matches(const FName& A, const FName& B) { return A.IsEqual(B, ENameCase::CaseSensitive); }
+        };
+
+        struct FStringKeyFuncs : TDefaultMapHashableKeyFuncs<FString, int32, false>
+        {
+            static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        };
+
+        struct FEntry
+        {
+            const char* Chars = nullptr; // anchored lua string
+            FName Name;
+            FString String;
+            bool bName = false;         // cached for FName, otherwise for FString
+            bool bReferenced = false;   // hit since the clock hand passed
+        };
+
+        /**
+         * Anchor the lua string at the index, returns its slot in the anchor table.
+         * Reaching MaxEntries, the slot is taken from an entry not hit recently (clock algorithm).
+         */
+        int32 Anchor(lua_State* L, int32 Index);
+
+        void Evict(int32 Slot);
+
+        void PushSlot(lua_State* L, int32 Slot);
+
+        FLuaEnv* Env;
+        int32 TableRef;
+        TArray<FEntry> Entries; // indexed by slot - 1
+        int32 ClockHand = 0;
+        TMap<FName, int32, FDefaultSetAllocator, FNameKeyFuncs> NameToSlot;
+        TMap<FString, int32, FDefaultSetAllocator, FStringKeyFuncs> StringToSlot;
+        TMap<const char*, int32> CharsToName; // anchored strings are alive, so their address identifies them
+        TMap<const char*, int32> CharsToString;
+        FStats Stats;
+    };
+}
@@ -0,0 +1,156 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaParamBufferArena.h"
+#include "LuaEnv.h"
+#include "UnLuaBase.h"
+
+namespace UnLua
+{
+    int32 FParamBufferArena::InitialSize = 4096;
+
+    FParamBufferArena::FParamBufferArena(FLuaEnv* Env)
+        : Env(Env)
+    {
+    }
+
+    FParamBufferArena::~FParamBufferArena()
+    {
+        check(Marks.Num() == 0);
+        FreeBlocks();
+    }
+
+    void FParamBufferArena::SetEnabled(bool bInEnabled)
+    {
+        bEnabled = bInEnabled;
+        if (!bEnabled && Marks.Num() == 0)
+            FreeBlocks();
+    }
+
+    void* FParamBufferArena::Push(int32 Size)
+    {
+        Size = Align(FMath::Max(Size, 1), Alignment);
+
+        FMark& Mark = Marks.AddDefaulted_GetRef();
+        Mark.Block = Current;
+        Mark.Offset = Offset;
+        Mark.Size = Size;
+
+        if (Blocks.Num() == 0 || Offset + Size > Blocks[Current].Size)
+            Grow(Size);
+
+        Mark.Memory = Blocks[Current].Data + Offset;
+        Offset += Size;
+
+        Stats.Pushes++;
+        Stats.Used += Size;
+        Stats.Peak = FMath::Max(Stats.Peak, Stats.Used);
+        Stats.Depth = Marks.Num();
+        Stats.MaxDepth = FMath::Max(Stats.MaxDepth, Stats.Depth);
+        return Mark.Memory;
+    }
+
+    void FParamBufferArena::Pop(void* Memory)
+    {
+        int32 Index = Marks.Num() - 1;
+        while (Index >= 0 && Marks[Index].Memory != Memory)
+            Index--;
+        check(Index >= 0);
+        Stats.Abandoned += Marks.Num() - Index - 1;
+        Unwind(Index);
+    }
+
+    void FParamBufferArena::Rewind(int32 Depth)
+    {
+        if (Depth >= Marks.Num())
+            return;
+
+        Stats.Abandoned += Marks.Num() - Depth;
+        Unwind(Depth);
+    }
+
+    void FParamBufferArena::Unwind(int32 Depth)
+    {
+        for (int32 i = Depth; i < Marks.Num(); i++)
+            Stats.Used -= Marks[i].Size;
+
+        Current = Marks[Depth].Block;
+        Offset = Marks[Depth].Offset;
+        Marks.SetNum(Depth, false);
+        Stats.Depth = Depth;
+
+        if (Depth == 0)
+        {
+            if (!bEnabled)
+                FreeBlocks();
+            else if (Blocks.Num() > 1)
+                Compact();
+        }
+    }
+
+    void FParamBufferArena::Report() const
+    {
+        UE_LOG(LogUnLua, Log, TEXT("%s param buffer arena: %s, %d bytes peak, %d bytes capacity in %d blocks, %d max depth, %d pushes, %d grows, %d abandoned."),
+               *Env->GetName(), bEnabled ? TEXT("enabled") : TEXT("disabled"), Stats.Peak, Stats.Capacity, Blocks.Num(), Stats.MaxDepth, Stats.Pushes, Stats.Grows, Stats.Abandoned);
+    }
+
+    void FParamBufferArena::Grow(int32 Size)
+    {
+        const int32 Next = Blocks.Num() == 0 ? 0 : Current + 1;
+
+        // blocks after the current one are free, drop those too small for this buffer
+        while (Blocks.Num() > Next && Blocks[Next].Size < Size)
+        {
+            Stats.Capacity -= Blocks[Next].Size;
+            FMemory::Free(Blocks[Next].Data);
+            Blocks.RemoveAt(Next);
+        }
+
+        if (Blocks.Num() == Next)
+        {
+            const int32 LastSize = Next > 0 ? Blocks[Next - 1].Size * 2 : InitialSize;
+            FBlock& Block = Blocks.AddDefaulted_GetRef();
+            Block.Size = Align(FMath::Max(Size, LastSize), Alignment);
+            Block.Data = (uint8*)FMemory::Malloc(Block.Size, Alignment);
+            Stats.Capacity += Block.Size;
+            Stats.Grows++;
+        }
+
+        Current = Next;
+        Offset = 0;
+    }
+
+    void FParamBufferArena::Compact()
+    {
+        check(Marks.Num() == 0);
+        const int32 Size = Align(FMath::Max(Stats.Peak, InitialSize), Alignment);
+        FreeBlocks();
+        FBlock& Block = Blocks.AddDefaulted_GetRef();
+        Block.Size = Size;
+        Block.Data = (uint8*)FMemory::Malloc(Block.Size, Alignment);
+        Stats.Capacity = Block.Size;
+        Stats.Grows++;
+    }
+
+    void FParamBufferArena::FreeBlocks()
+    {
+        for (const auto& Block : Blocks)
+            FMemory::Free(Block.Data);
+        Blocks.Empty();
+        Current = 0;
+        Offset = 0;
+        Stats.Capacity = 0;
+    }
+}
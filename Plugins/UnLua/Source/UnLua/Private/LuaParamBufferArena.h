@@ -0,0 +1,140 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Bump arena for parameter buffers of UFunction calls in a lua env. Buffers are pushed and popped
+     * in LIFO order, so nested Lua<->UE calls rewind correctly, and the memory is left uninitialized
+     * for callers to construct each parameter in place.
+     */
+    class UNLUA_API FParamBufferArena
+    {
+    public:
+        static constexpr int32 Alignment = 16;
+
+        static int32 InitialSize; // bytes of the first block
+
+        /**
+         * Rewind to the depth on construction when a protected call returns, successful or not.
+         * Errors caught by 'pcall' or coroutines in scripts jump over the scopes of buffers as well.
+         */
+        class FGuard final
+        {
+        public:
+            explicit FGuard(FParamBufferArena* InOwner)
+                : Owner(InOwner), Depth(InOwner ? InOwner->GetDepth() : 0)
+            {
+            }
+
+            ~FGuard()
+            {
+                if (Owner)
+                    Owner->Rewind(Depth);
+            }
+
+        private:
+            FParamBufferArena* Owner;
+            int32 Depth;
+        };
+
+        struct FStats
+        {
+            int32 Used = 0;         // bytes used by outstanding buffers
+            int32 Peak = 0;         // max bytes used at once
+            int32 Capacity = 0;     // bytes reserved by all blocks
+            int32 Depth = 0;        // outstanding buffers
+            int32 MaxDepth = 0;     // max outstanding buffers at once
+            int32 Pushes = 0;       // buffers pushed
+            int32 Grows = 0;        // blocks allocated
+            int32 Abandoned = 0;    // buffers rewound without popping, lua errors jump over their scopes
+        };
+
+        explicit FParamBufferArena(FLuaEnv* Env);
+
+        ~FParamBufferArena();
+
+        FORCEINLINE bool IsEnabled() const { return bEnabled; }
+
+        /**
+         * Switch the env between the arena and per function allocators, outstanding buffers are still popped here
+         */
+        void SetEnabled(bool bInEnabled);
+
+        /**
+         * Push an uninitialized buffer, which stays valid until it is popped
+         */
+        void* Push(int32 Size);
+
+        /**
+         * Pop the last pushed buffer, and those abandoned above it
+         */
+        void Pop(void* Memory);
+
+        FORCEINLINE int32 GetDepth() const { return Marks.Num(); }
+
+        /**
+         * Rewind to a depth got before a protected call, in case buffers were left behind by errors
+         */
+        void Rewind(int32 Depth);
+
+        void Report() const;
+
+        FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+    private:
+        struct FBlock
+        {
+            uint8* Data;
+            int32 Size;
+        };
+
+        struct FMark
+        {
+            int32 Block;    // position before the buffer was pushed
+            int32 Offset;
+            int32 Size;
+            void* Memory;
+        };
+
+        /**
+         * Move to a block with at least Size free bytes, earlier blocks are kept for outstanding buffers
+         */
+        void Grow(int32 Size);
+
+        void Unwind(int32 Depth);
+
+        /**
+         * Merge all blocks into one sized to the peak usage, only when no buffer is outstanding
+         */
+        void Compact();
+
+        void FreeBlocks();
+
+        FLuaEnv* Env;
+        TArray<FBlock> Blocks;
+        TArray<FMark> Marks;
+        int32 Current = 0;
+        int32 Offset = 0;
+        FStats Stats;
+        bool bEnabled = false;
+    };
+}
@@ -0,0 +1,163 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaPoolAllocator.h"
+#include <cstring>
+
+namespace UnLua
+{
+    // keep blocks aligned as malloc does
+    static constexpr size_t PageHeaderSize = (sizeof(void*) + FLuaPoolAllocator::Granularity - 1) / FLuaPoolAllocator::Granularity * FLuaPoolAllocator::Granularity;
+
+    FLuaPoolAllocator::FLuaPoolAllocator(FBackend InBackend)
+        : Backend(InBackend), Pages(nullptr)
+    {
+        for (size_t i = 0; i < NumClasses; i++)
+        {
+            FreeLists[i] = nullptr;
+            Cursors[i] = nullptr;
+            Ends[i] = nullptr;
+        }
+    }
+
+    FLuaPoolAllocator::~FLuaPoolAllocator()
+    {
+        ReleasePages();
+    }
+
+    void FLuaPoolAllocator::ReleasePages()
+    {
+        while (Pages)
+        {
+            FPage* Next = Pages->Next;
+            Backend(nullptr, Pages, PageSize, 0);
+            Pages = Next;
+        }
+        for (size_t i = 0; i < NumClasses; i++)
+        {
+            FreeLists[i] = nullptr;
+            Cursors[i] = nullptr;
+            Ends[i] = nullptr;
+        }
+        Stats.PageBytes = 0;
+        Stats.Pages = 0;
+    }
+
+    void* FLuaPoolAllocator::Alloc(void* UserData, void* Ptr, size_t OldSize, size_t NewSize)
+    {
+        return static_cast<FLuaPoolAllocator*>(UserData)->Realloc(Ptr, OldSize, NewSize);
+    }
+
+    void* FLuaPoolAllocator::Realloc(void* Ptr, size_t OldSize, size_t NewSize)
+    {
+        // lua passes type of the object in OldSize for new blocks
+        if (!Ptr)
+            OldSize = 0;
+
+        const bool bOldSmall = Ptr && OldSize <= MaxSmallSize;
+        const bool bNewSmall = NewSize <= MaxSmallSize;
+
+        if (NewSize == 0)
+        {
+            if (bOldSmall)
+                FreeSmall(Ptr, OldSize);
+            else if (Ptr)
+                ReallocLarge(Ptr, OldSize, 0);
+            return nullptr;
+        }
+
+        if (bOldSmall && bNewSmall && GetClassIndex(OldSize) == GetClassIndex(NewSize))
+        {
+            Stats.SmallBytes = Stats.SmallBytes - OldSize + NewSize;
+            return Ptr;
+        }
+
+        if (Ptr && !bOldSmall && !bNewSmall)
+            return ReallocLarge(Ptr, OldSize, NewSize);
+
+        void* NewPtr = bNewSmall ? AllocSmall(NewSize) : ReallocLarge(nullptr, 0, NewSize);
+        if (!NewPtr || !Ptr)
+            return NewPtr;
+
+        memcpy(NewPtr, Ptr, OldSize < NewSize ? OldSize : NewSize);
+        if (bOldSmall)
+            FreeSmall(Ptr, OldSize);
+        else
+            ReallocLarge(Ptr, OldSize, 0);
+        return NewPtr;
+    }
+
+    void* FLuaPoolAllocator::AllocSmall(const size_t Size)
+    {
+        const size_t ClassIndex = GetClassIndex(Size);
+        void* Block = FreeLists[ClassIndex];
+        if (Block)
+        {
+            FreeLists[ClassIndex] = FreeLists[ClassIndex]->Next;
+        }
+        else
+        {
+            const size_t BlockSize = (ClassIndex + 1) * Granularity;
+            if ((size_t)(Ends[ClassIndex] - Cursors[ClassIndex]) < BlockSize)
+            {
+                FPage* Page = static_cast<FPage*>(Backend(nullptr, nullptr, 0, PageSize));
+                if (!Page)
+                    return nullptr;
+                Page->Next = Pages;
+                Pages = Page;
+                Cursors[ClassIndex] = reinterpret_cast<char*>(Page) + PageHeaderSize;
+                Ends[ClassIndex] = reinterpret_cast<char*>(Page) + PageSize;
+                Stats.PageBytes += PageSize;
+                Stats.Pages++;
+                UpdateHighWater();
+            }
+            Block = Cursors[ClassIndex];
+            Cursors[ClassIndex] += BlockSize;
+        }
+
+        Stats.SmallBytes += Size;
+        Stats.SmallAllocs++;
+        return Block;
+    }
+
+    void FLuaPoolAllocator::FreeSmall(void* Ptr, const size_t Size)
+    {
+        const size_t ClassIndex = GetClassIndex(Size);
+        FFreeBlock* Block = static_cast<FFreeBlock*>(Ptr);
+        Block->Next = FreeLists[ClassIndex];
+        FreeLists[ClassIndex] = Block;
+        Stats.SmallBytes -= Size;
+    }
+
+    void* FLuaPoolAllocator::ReallocLarge(void* Ptr, const size_t OldSize, const size_t NewSize)
+    {
+        void* NewPtr = Backend(nullptr, Ptr, OldSize, NewSize);
+        if (NewSize && !NewPtr)
+            return nullptr;
+
+        Stats.LargeBytes = Stats.LargeBytes - OldSize + NewSize;
+        if (!Ptr)
+            Stats.LargeAllocs++;
+        UpdateHighWater();
+        return NewPtr;
+    }
+
+    void FLuaPoolAllocator::UpdateHighWater()
+    {
+        const size_t Reserved = Stats.PageBytes + Stats.LargeBytes;
+        if (Reserved > Stats.HighWater)
+            Stats.HighWater = Reserved;
+    }
+}
@@ -0,0 +1,102 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+
+namespace UnLua
+{
+    /**
+     * Lua allocator serving small blocks from size-class pools, large blocks and pages come from a backend allocator.
+     * Pools are owned by one lua env and only touched by the thread running it, so no locking is needed.
+     * Keep it free of engine dependencies, it is also built by the standalone benchmark of ThirdParty/Lua.
+     */
+    class FLuaPoolAllocator
+    {
+    public:
+        /** lua_Alloc compatible backend, frees the block when NewSize is 0 */
+        typedef void* (*FBackend)(void* UserData, void* Ptr, size_t OldSize, size_t NewSize);
+
+        static constexpr size_t Granularity = 16;
+        static constexpr size_t MaxSmallSize = 256;
+        static constexpr size_t NumClasses = MaxSmallSize / Granularity;
+        static constexpr size_t PageSize = 16 * 1024;
+
+        struct FStats
+        {
+            size_t SmallBytes = 0;      // live bytes requested as small blocks
+            size_t PageBytes = 0;       // bytes reserved by pages
+            size_t LargeBytes = 0;      // live bytes of large blocks
+            size_t HighWater = 0;       // peak of PageBytes + LargeBytes
+            size_t SmallAllocs = 0;     // small blocks allocated
+            size_t LargeAllocs = 0;     // large blocks allocated
+            size_t Pages = 0;           // pages reserved
+
+            /** Ratio of page memory not used by live blocks, including size class rounding */
+            double GetFragmentation() const { return PageBytes ? 1.0 - (double)SmallBytes / PageBytes : 0; }
+        };
+
+        explicit FLuaPoolAllocator(FBackend InBackend);
+
+        ~FLuaPoolAllocator();
+
+        FLuaPoolAllocator(const FLuaPoolAllocator&) = delete;
+
+        FLuaPoolAllocator& operator=(const FLuaPoolAllocator&) = delete;
+
+        /**
+         * lua_Alloc entry, UserData should be the allocator
+         */
+        static void* Alloc(void* UserData, void* Ptr, size_t OldSize, size_t NewSize);
+
+        void* Realloc(void* Ptr, size_t OldSize, size_t NewSize);
+
+        /**
+         * Return all pages to the backend, only call it once every small block has been freed, e.g. after lua_close
+         */
+        void ReleasePages();
+
+        const FStats& GetStats() const { return Stats; }
+
+    private:
+        struct FFreeBlock
+        {
+            FFreeBlock* Next;
+        };
+
+        struct FPage
+        {
+            FPage* Next;
+        };
+
+        static size_t GetClassIndex(const size_t Size) { return (Size - 1) / Granularity; }
+
+        void* AllocSmall(size_t Size);
+
+        void FreeSmall(void* Ptr, size_t Size);
+
+        void* ReallocLarge(void* Ptr, size_t OldSize, size_t NewSize);
+
+        void UpdateHighWater();
+
+        FBackend Backend;
+        FFreeBlock* FreeLists[NumClasses];
+        char* Cursors[NumClasses];  // next unused block in the current page of each class
+        char* Ends[NumClasses];
+        FPage* Pages;
+        FStats Stats;
+    };
+}
@@ -0,0 +1,198 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaPreBind.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "LuaEnv.h"
+#include "LuaEnvLocator.h"
+#include "LuaModuleLocator.h"
+#include "UnLuaBase.h"
+#include "UnLuaPrivate.h"
+#include "UnLuaSettings.h"
+
+namespace UnLua
+{
+    static const TCHAR* PreBindClassTag = TEXT("#PreBindClass\t");
+
+    FString FPreBindManifest::GetPath()
+    {
+        return GLuaSrcFullPath + TEXT("UnLuaPreBind.txt");
+    }
+
+    bool FPreBindManifest::Load(const FString& Path)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+            return false;
+
+        Entries.Reset(Lines.Num());
+        PreBindClasses.Reset();
+        for (const auto& Line : Lines)
+        {
+            if (Line.StartsWith(PreBindClassTag, ESearchCase::CaseSensitive))
+            {
+                PreBindClasses.Add(Line.RightChop(FCString::Strlen(PreBindClassTag)).TrimStartAndEnd());
+                continue;
+            }
+
+            // ClassPath[\tModuleName]
+            FString ClassPath;
+            FString ModuleName;
+            if (!Line.Split(TEXT("\t"), &ClassPath, &ModuleName))
+                ClassPath = Line;
+            ClassPath.TrimStartAndEndInline();
+            if (ClassPath.IsEmpty() || ClassPath.StartsWith(TEXT("#")))
+                continue;
+            Entries.Add({MoveTemp(ClassPath), ModuleName.TrimStartAndEnd()});
+        }
+        return true;
+    }
+
+    bool FPreBindManifest::Save(const FString& Path) const
+    {
+        TArray<FString> Lines;
+        Lines.Reserve(Entries.Num() + PreBindClasses.Num() + 1);
+        Lines.Add(TEXT("# generated by UnLuaPreBind commandlet, ClassPath<TAB>ModuleName"));
+        for (const auto& ClassPath : PreBindClasses)
+            Lines.Add(PreBindClassTag + ClassPath);
+        for (const auto& Entry : Entries)
+            Lines.Add(Entry.ModuleName.IsEmpty() ? Entry.ClassPath : Entry.ClassPath + TEXT("\t") + Entry.ModuleName);
+        return FFileHelper::SaveStringArrayToFile(Lines, *Path);
+    }
+
+    void FPreBindManifest::Collect(const TArray<FSoftClassPath>& InPreBindClasses, ULuaModuleLocator* ModuleLocator)
+    {
+        // resolve once instead of for every loaded class
+        TArray<UClass*> TargetClasses;
+        PreBindClasses.Reset();
+        for (const auto& ClassPath : InPreBindClasses)
+        {
+            if (!ClassPath.IsValid())
+                continue;
+            PreBindClasses.AddUnique(ClassPath.ToString());
+            if (const auto TargetClass = ClassPath.ResolveClass())
+                TargetClasses.AddUnique(TargetClass);
+        }
+
+        Entries.Reset();
+        if (TargetClasses.Num() == 0)
+            return;
+
+        for (const auto Class : TObjectRange<UClass>())
+        {
+            for (const auto TargetClass : TargetClasses)
+            {
+                if (!Class->IsChildOf(TargetClass))
+                    continue;
+
+                FEntry Entry;
+                Entry.ClassPath = Class->GetPathName();
+                if (ModuleLocator)
+                    Entry.ModuleName = ModuleLocator->Locate(Class);
+                Entries.Add(MoveTemp(Entry));
+                break;
+            }
+        }
+    }
+
+    FPreBindManifest::FTimings FPreBindManifest::PreBind(ULuaEnvLocator* EnvLocator, const TArray<FSoftClassPath>& PreBindClasses)
+    {
+        FTimings Timings;
+        double Time = FPlatformTime::Seconds();
+
+        const auto ModuleLocator = GetDefault<UUnLuaSettings>()->ModuleLocatorClass.GetDefaultObject();
+        FPreBindManifest Manifest;
+        Timings.bFromManifest = FPlatformProperties::RequiresCookedData() && Manifest.Load(GetPath());
+        if (Timings.bFromManifest)
+        {
+            // classes configured after the manifest was generated are scanned as if there were no manifest
+            TArray<FSoftClassPath> Uncovered;
+            for (const auto& ClassPath : PreBindClasses)
+            {
+                if (ClassPath.IsValid() && !Manifest.PreBindClasses.Contains(ClassPath.ToString()))
+                    Uncovered.AddUnique(ClassPath);
+            }
+
+            if (Uncovered.Num() > 0)
+            {
+                TArray<FString> Names;
+                for (const auto& ClassPath : Uncovered)
+                    Names.Add(ClassPath.ToString());
+                UE_LOG(LogUnLua, Warning, TEXT("PreBind classes not covered by manifest %s, regenerate it with UnLuaPreBind commandlet: %s"),
+                       *GetPath(), *FString::Join(Names, TEXT(", ")));
+
+                TSet<FString> Listed;
+                for (const auto& Entry : Manifest.Entries)
+                    Listed.Add(Entry.ClassPath);
+
+                FPreBindManifest Scanned;
+                Scanned.Collect(Uncovered, ModuleLocator);
+                for (auto& Entry : Scanned.Entries)
+                {
+                    if (!Listed.Contains(Entry.ClassPath))
+                        Manifest.Entries.Add(MoveTemp(Entry));
+                }
+            }
+        }
+        else
+        {
+            Manifest.Collect(PreBindClasses, ModuleLocator);
+        }
+
+        TArray<TPair<UClass*, FLuaEnv*>> Classes;
+        TMap<FLuaEnv*, TArray<FString>> Modules;
+        Classes.Reserve(Manifest.Entries.Num());
+        for (const auto& Entry : Manifest.Entries)
+        {
+            const auto Class = FSoftClassPath(Entry.ClassPath).ResolveClass();
+            if (!Class)
+                continue;
+
+            const auto Env = EnvLocator->Locate(Class);
+            if (!Env)
+                continue;
+
+            Classes.Emplace(Class, Env);
+            if (!Entry.ModuleName.IsEmpty())
+                Modules.FindOrAdd(Env).AddUnique(Entry.ModuleName);
+        }
+
+        double Now = FPlatformTime::Seconds();
+        Timings.Resolve = Now - Time;
+        Time = Now;
+
+        for (const auto& Pair : Modules)
+            Timings.Modules += Pair.Key->GetFileSystemCache()->Prefetch(Pair.Key->GetMainState(), Pair.Value);
+
+        Now = FPlatformTime::Seconds();
+        Timings.Prefetch = Now - Time;
+        Time = Now;
+
+        // lua states are only touched here
+        for (const auto& Pair : Classes)
+        {
+            if (Pair.Value->TryBind(Pair.Key))
+                Timings.Classes++;
+        }
+
+        // drop chunks not required by binding, they would go stale
+        for (const auto& Pair : Modules)
+            Pair.Key->GetFileSystemCache()->ClearPrefetched();
+
+        Timings.Bind = FPlatformTime::Seconds() - Time;
+        return Timings;
+    }
+}
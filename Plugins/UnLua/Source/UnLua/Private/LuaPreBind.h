@@ -0,0 +1,74 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULuaEnvLocator;
+class ULuaModuleLocator;
+
+namespace UnLua
+{
+    /**
+     * Classes to bind on startup, generated at cook time to skip scanning every class
+     */
+    class UNLUA_API FPreBindManifest
+    {
+    public:
+        struct FEntry
+        {
+            FString ClassPath;
+            FString ModuleName; // empty if not resolved, the class is bound without prefetching
+        };
+
+        /**
+         * Time spent in each phase of prebinding, in seconds
+         */
+        struct FTimings
+        {
+            bool bFromManifest = false; // entries loaded from manifest instead of scanning classes
+            int32 Classes = 0;          // classes bound
+            int32 Modules = 0;          // modules read and compiled in worker threads
+            double Resolve = 0;         // find classes and their envs
+            double Prefetch = 0;        // read and compile modules
+            double Bind = 0;            // bind classes in game thread
+        };
+
+        TArray<FEntry> Entries;
+
+        TArray<FString> PreBindClasses; // configured classes the entries were collected for
+
+        static FString GetPath();
+
+        bool Load(const FString& Path);
+
+        bool Save(const FString& Path) const;
+
+        /**
+         * Scan loaded classes for children of InPreBindClasses
+         *
+         * @param ModuleLocator - resolve module names of found classes, optional
+         */
+        void Collect(const TArray<FSoftClassPath>& InPreBindClasses, ULuaModuleLocator* ModuleLocator);
+
+        /**
+         * Bind classes listed in manifest in cooked builds or found by scanning otherwise,
+         * configured classes not covered by the manifest are scanned and merged.
+         * modules are read and compiled in worker threads before binding
+         */
+        static FTimings PreBind(ULuaEnvLocator* EnvLocator, const TArray<FSoftClassPath>& PreBindClasses);
+    };
+}
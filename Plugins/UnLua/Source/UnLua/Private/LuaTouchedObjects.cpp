@@ -0,0 +1,39 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaTouchedObjects.h"
+#include "LuaEnv.h"
+#include "UnLuaBase.h"
+
+namespace UnLua
+{
+    FLuaTouchedObjects::FLuaTouchedObjects(FLuaEnv* Env)
+        : Env(Env)
+    {
+    }
+
+    void FLuaTouchedObjects::Report() const
+    {
+        UE_LOG(LogUnLua, Log, TEXT("%s touched objects: %d touched, %d deleted, %d skipped, %d bytes."),
+               *Env->GetName(), Stats.Touched, Stats.Deleted, Stats.Skipped, Words.Num() * (int32)sizeof(uint32));
+    }
+
+    void FLuaTouchedObjects::Grow(int32 Word)
+    {
+        // size to the whole object array at once, it rarely grows afterwards
+        const int32 NumWords = FMath::Max(Word + 1, (GUObjectArray.GetObjectArrayNum() + 31) >> 5);
+        Words.SetNumZeroed(NumWords);
+    }
+}
@@ -0,0 +1,91 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+
+namespace UnLua
+{
+    class FLuaEnv;
+
+    /**
+     * Bitset of objects ever referenced by registries of a lua env, indexed by GUObjectArray index,
+     * so the delete listener returns after a single bit test for objects lua never saw
+     */
+    class UNLUA_API FLuaTouchedObjects
+    {
+    public:
+        struct FStats
+        {
+            int32 Touched = 0;      // marked objects not deleted yet
+            int32 Deleted = 0;      // delete notifications received
+            int32 Skipped = 0;      // delete notifications returned after the bit test
+        };
+
+        explicit FLuaTouchedObjects(FLuaEnv* Env);
+
+        FORCEINLINE void Mark(const UObjectBase* Object)
+        {
+            if (!Object)
+                return;
+
+            const int32 Index = GUObjectArray.ObjectToIndex(Object);
+            if (Index < 0)
+                return;
+
+            const int32 Word = Index >> 5;
+            const uint32 Bit = 1u << (Index & 31);
+            if (Word >= Words.Num())
+                Grow(Word);
+            if (Words[Word] & Bit)
+                return;
+            Words[Word] |= Bit;
+            Stats.Touched++;
+        }
+
+        FORCEINLINE bool IsTouched(int32 Index) const
+        {
+            const int32 Word = Index >> 5;
+            return Words.IsValidIndex(Word) && (Words[Word] & (1u << (Index & 31))) != 0;
+        }
+
+        /** Clears the bit of a deleted object, returns false if lua never saw it */
+        FORCEINLINE bool TestAndClear(int32 Index)
+        {
+            Stats.Deleted++;
+            if (!IsTouched(Index))
+            {
+                Stats.Skipped++;
+                return false;
+            }
+            Words[Index >> 5] &= ~(1u << (Index & 31));
+            Stats.Touched--;
+            return true;
+        }
+
+        FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+        void Report() const;
+
+    private:
+        void Grow(int32 Word);
+
+        FLuaEnv* Env;
+        TArray<uint32> Words;
+        FStats Stats;
+    };
+}
@@ -76,6 +76,11 @@ static int32 FIntPoint_UNM(lua_State* L)
 static const luaL_Reg FIntPointLib[] =
 {
     {"Set", FIntPoint_Set},
+    {"AddInPlace", UnLua::TMathCalculation<FIntPoint, UnLua::TAdd<int32>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FIntPoint, UnLua::TSub<int32>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FIntPoint, UnLua::TMul<int32>, true>::Calculate},
+    {"DivInPlace", UnLua::TMathCalculation<FIntPoint, UnLua::TDiv<int32>, true>::Calculate},
+    // old names of the in-place versions
     {"Add", UnLua::TMathCalculation<FIntPoint, UnLua::TAdd<int32>, true>::Calculate},
     {"Sub", UnLua::TMathCalculation<FIntPoint, UnLua::TSub<int32>, true>::Calculate},
     {"Mul", UnLua::TMathCalculation<FIntPoint, UnLua::TMul<int32>, true>::Calculate},
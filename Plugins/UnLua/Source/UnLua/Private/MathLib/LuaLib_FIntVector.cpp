@@ -93,6 +93,11 @@ static const luaL_Reg FIntVectorLib[] =
 {
     {"Set", FIntVector_Set},
     {"SizeSquared", FIntVector_SizeSquared},
+    {"AddInPlace", UnLua::TMathCalculation<FIntVector, UnLua::TAdd<int32>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FIntVector, UnLua::TSub<int32>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FIntVector, UnLua::TMul<int32>, true>::Calculate},
+    {"DivInPlace", UnLua::TMathCalculation<FIntVector, UnLua::TDiv<int32>, true>::Calculate},
+    // old names of the in-place versions
     {"Add", UnLua::TMathCalculation<FIntVector, UnLua::TAdd<int32>, true>::Calculate},
     {"Sub", UnLua::TMathCalculation<FIntVector, UnLua::TSub<int32>, true>::Calculate},
     {"Mul", UnLua::TMathCalculation<FIntVector, UnLua::TMul<int32>, true>::Calculate},
@@ -69,6 +69,11 @@ static int32 FLinearColor_Set(lua_State* L)
 static const luaL_Reg FLinearColorLib[] =
 {
     {"Set", FLinearColor_Set},
+    {"AddInPlace", UnLua::TMathCalculation<FLinearColor, UnLua::TAdd<float>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FLinearColor, UnLua::TSub<float>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FLinearColor, UnLua::TMul<float>, true>::Calculate},
+    {"DivInPlace", UnLua::TMathCalculation<FLinearColor, UnLua::TDiv<float>, true>::Calculate},
+    // old names of the in-place versions
     {"Add", UnLua::TMathCalculation<FLinearColor, UnLua::TAdd<float>, true>::Calculate},
     {"Sub", UnLua::TMathCalculation<FLinearColor, UnLua::TSub<float>, true>::Calculate},
     {"Mul", UnLua::TMathCalculation<FLinearColor, UnLua::TMul<float>, true>::Calculate},
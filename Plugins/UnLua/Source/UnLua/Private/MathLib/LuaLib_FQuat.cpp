@@ -123,6 +123,8 @@ static const luaL_Reg FQuatLib[] =
     {"Normalize", FQuat_Normalize},
     {"FromAxisAndAngle", FQuat_FromAxisAndAngle},
     {"Set", FQuat_Set},
+    {"MulInPlace", UnLua::TMathCalculation<FQuat, UnLua::TMul<FQuat>, true, UnLua::TMul<FQuat, unluaReal>>::Calculate},
+    // old names of the in-place versions
     {"Mul", UnLua::TMathCalculation<FQuat, UnLua::TMul<FQuat>, true, UnLua::TMul<FQuat, unluaReal>>::Calculate},
     {"__mul", UnLua::TMathCalculation<FQuat, UnLua::TMul<FQuat>, false, UnLua::TMul<FQuat, unluaReal>>::Calculate},
     {"__tostring", UnLua::TMathUtils<FQuat>::ToString},
@@ -113,6 +113,12 @@ static const luaL_Reg FRotatorLib[] =
     {"GetUnitAxis", FRotator_GetUnitAxis},
     {"__tostring", UnLua::TMathUtils<FRotator>::ToString},
     {"Set", FRotator_Set},
+    {"AddInPlace", UnLua::TMathCalculation<FRotator, UnLua::TAdd<unluaReal>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FRotator, UnLua::TSub<unluaReal>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FRotator, UnLua::TMul<unluaReal>, true>::Calculate},
+    {"__add", UnLua::TMathCalculation<FRotator, UnLua::TAdd<unluaReal>>::Calculate},
+    {"__sub", UnLua::TMathCalculation<FRotator, UnLua::TSub<unluaReal>>::Calculate},
+    {"__mul", UnLua::TMathCalculation<FRotator, UnLua::TMul<unluaReal>>::Calculate},
     {"__call", FRotator_New},
     {nullptr, nullptr}
 };
@@ -128,9 +134,6 @@ BEGIN_EXPORT_REFLECTED_CLASS(FRotator)
     ADD_NAMED_FUNCTION("ToEuler", Euler)
     ADD_NAMED_FUNCTION("ToQuat", Quaternion)
     ADD_NAMED_FUNCTION("Inverse", GetInverse)
-    ADD_CONST_FUNCTION_EX("__add", FRotator, operator+, const FRotator&)
-    ADD_CONST_FUNCTION_EX("__sub", FRotator, operator-, const FRotator&)
-    ADD_CONST_FUNCTION_EX("__mul", FRotator, operator*, float)
     ADD_FUNCTION_EX("Add", FRotator, operator+=, const FRotator&)
     ADD_FUNCTION_EX("Sub", FRotator, operator-=, const FRotator&)
     ADD_FUNCTION_EX("Mul", FRotator, operator*=, unluaReal)
@@ -146,6 +146,8 @@ static const luaL_Reg FTransformLib[] =
 {
     {"Blend", FTransform_Blend},
     {"BlendWith", FTransform_BlendWith},
+    {"MulInPlace", UnLua::TMathCalculation<FTransform, UnLua::TMul<FTransform>, true, UnLua::TMul<FTransform, float>>::Calculate},
+    // old names of the in-place versions
     {"Mul", UnLua::TMathCalculation<FTransform, UnLua::TMul<FTransform>, true, UnLua::TMul<FTransform, float>>::Calculate},
     {"__mul", UnLua::TMathCalculation<FTransform, UnLua::TMul<FTransform>, false, UnLua::TMul<FTransform, float>>::Calculate},
     {"__tostring", UnLua::TMathUtils<FTransform>::ToString},
@@ -106,6 +106,11 @@ static const luaL_Reg FVectorLib[] =
 {
     {"Set", FVector_Set},
     {"Normalize", FVector_Normalize},
+    {"AddInPlace", UnLua::TMathCalculation<FVector, UnLua::TAdd<unluaReal>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FVector, UnLua::TSub<unluaReal>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FVector, UnLua::TMul<unluaReal>, true>::Calculate},
+    {"DivInPlace", UnLua::TMathCalculation<FVector, UnLua::TDiv<unluaReal>, true>::Calculate},
+    // old names of the in-place versions
     {"Add", UnLua::TMathCalculation<FVector, UnLua::TAdd<unluaReal>, true>::Calculate},
     {"Sub", UnLua::TMathCalculation<FVector, UnLua::TSub<unluaReal>, true>::Calculate},
     {"Mul", UnLua::TMathCalculation<FVector, UnLua::TMul<unluaReal>, true>::Calculate},
@@ -124,6 +124,11 @@ static const luaL_Reg FVector2DLib[] =
     {"Set", FVector2D_Set},
     {"Normalize", FVector2D_Normalize},
     {"IsNormalized", FVector2D_IsNormalized},
+    {"AddInPlace", UnLua::TMathCalculation<FVector2D, UnLua::TAdd<unluaReal>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FVector2D, UnLua::TSub<unluaReal>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FVector2D, UnLua::TMul<unluaReal>, true>::Calculate},
+    {"DivInPlace", UnLua::TMathCalculation<FVector2D, UnLua::TDiv<unluaReal>, true>::Calculate},
+    // old names of the in-place versions
     {"Add", UnLua::TMathCalculation<FVector2D, UnLua::TAdd<unluaReal>, true>::Calculate},
     {"Sub", UnLua::TMathCalculation<FVector2D, UnLua::TSub<unluaReal>, true>::Calculate},
     {"Mul", UnLua::TMathCalculation<FVector2D, UnLua::TMul<unluaReal>, true>::Calculate},
@@ -91,6 +91,11 @@ static int32 FVector4_UNM(lua_State* L)
 static const luaL_Reg FVector4Lib[] =
 {
     {"Set", FVector4_Set},
+    {"AddInPlace", UnLua::TMathCalculation<FVector4, UnLua::TAdd<unluaReal>, true>::Calculate},
+    {"SubInPlace", UnLua::TMathCalculation<FVector4, UnLua::TSub<unluaReal>, true>::Calculate},
+    {"MulInPlace", UnLua::TMathCalculation<FVector4, UnLua::TMul<unluaReal>, true>::Calculate},
+    {"DivInPlace", UnLua::TMathCalculation<FVector4, UnLua::TDiv<unluaReal>, true>::Calculate},
+    // old names of the in-place versions
     {"Add", UnLua::TMathCalculation<FVector4, UnLua::TAdd<unluaReal>, true>::Calculate},
     {"Sub", UnLua::TMathCalculation<FVector4, UnLua::TSub<unluaReal>, true>::Calculate},
     {"Mul", UnLua::TMathCalculation<FVector4, UnLua::TMul<unluaReal>, true>::Calculate},
@@ -16,6 +16,7 @@
 
 #include "LuaCore.h"
 #include "UnLuaCompatibility.h"
+#include "UnLuaTemplate.h"
 
 static uint64 GetTypeHash(lua_State* L, int32 Index)
 {
@@ -307,7 +308,8 @@ namespace UnLua
     {
         static T* GetResult(lua_State* L, T* A)
         {
-            void* Userdata = NewUserdataWithPadding(L, sizeof(T), UnLua::TType<T>::GetName(), CalcUserdataPadding<T>());
+            static const UScriptStruct* Type = TScriptStructTraits<T>::Get();
+            void* Userdata = NewUserdataWithPadding(L, sizeof(T), Type, CalcUserdataPadding<T>());
             T* V = new(Userdata) T;
             return V;
         }
@@ -327,6 +329,9 @@ namespace UnLua
 
     /**
      * Helper to do math calculation
+     *
+     * 'A op B' returns a new value, 'A:OpInPlace(B)' stores the result in A, 'T.OpInPlace(Out, A, B)' stores the result in Out.
+     * The latter two return the target for chaining and never allocate.
      */
     template <typename T, typename OperatorType, bool bAssignment = false, typename ScalarOperatorType = OperatorType>
     struct TMathCalculation
@@ -337,41 +342,59 @@ namespace UnLua
         static int32 Calculate(lua_State* L)
         {
             int32 NumParams = lua_gettop(L);
-            if (NumParams != 2)
+            const bool bOutParam = bAssignment && NumParams == 3;
+            if (NumParams != 2 && !bOutParam)
                 return luaL_error(L, "invalid parameters");
 
-            T* A = (T*)GetCppInstanceFast(L, 1);
+            const int32 IndexA = bOutParam ? 2 : 1;
+            const int32 IndexB = IndexA + 1;
+
+            T* A = (T*)GetCppInstanceFast(L, IndexA);
             if (!A)
                 return luaL_error(L, "invalid parameter A");
 
-            int32 ParamType = lua_type(L, 2);
+            int32 ParamType = lua_type(L, IndexB);
             if (ParamType != LUA_TUSERDATA && ParamType != LUA_TNUMBER)
             {
                 return luaL_error(L, "invalid parameter B");
             }
 
-            T* Result = TResultHelper<T, bAssignment>::GetResult(L, A);
+            T* Result;
+            if (bOutParam)
+            {
+                Result = (T*)GetCppInstanceFast(L, 1);
+                if (!Result || GetTypeHash(L, 1) != GetTypeHash(L, IndexA))
+                    return luaL_error(L, "invalid parameter Out");
+            }
+            else
+            {
+                Result = TResultHelper<T, bAssignment>::GetResult(L, A);
+            }
+
             switch (ParamType)
             {
             case LUA_TUSERDATA:
                 {
-                    uint64 Type1 = GetTypeHash(L, 1);
-                    uint64 Type2 = GetTypeHash(L, 2);
+                    uint64 Type1 = GetTypeHash(L, IndexA);
+                    uint64 Type2 = GetTypeHash(L, IndexB);
                     if (!Type1 || !Type2 || Type1 != Type2)
                         return luaL_error(L, "invalid parameters, incompatible types");
 
-                    T* B = (T*)GetCppInstanceFast(L, 2);
+                    T* B = (T*)GetCppInstanceFast(L, IndexB);
                     TMathCalculationHelper<FT, ST, OperatorType, ScalarOperatorType, TMathTypeTraits<T>::NUM_FIELDS>::Calculate(reinterpret_cast<FT*>(Result), reinterpret_cast<FT*>(A), reinterpret_cast<FT*>(B), OperatorType());
                 }
                 break;
             case LUA_TNUMBER:
                 {
-                    float B = lua_tonumber(L, 2);
+                    float B = lua_tonumber(L, IndexB);
                     TMathCalculationHelper<FT, ST, OperatorType, ScalarOperatorType, TMathTypeTraits<T>::NUM_FIELDS>::Calculate(reinterpret_cast<FT*>(Result), reinterpret_cast<FT*>(A), (ST)B, ScalarOperatorType());
                 }
                 break;
             }
-            return bAssignment ? 0 : 1;
+
+            if (bAssignment)
+                lua_pushvalue(L, 1);
+            return 1;
         }
     };
 
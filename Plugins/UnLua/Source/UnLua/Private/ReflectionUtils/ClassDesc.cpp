@@ -27,7 +27,7 @@
  * Class descriptor constructor
  */
 FClassDesc::FClassDesc(UnLua::FLuaEnv* Env, UStruct* InStruct, const FString& InName)
-    : Struct(InStruct), ClassName(InName), UserdataPadding(0), Size(0), Env(Env), FunctionCollection(nullptr)
+    : Struct(InStruct), ClassName(InName), UserdataPadding(0), Size(0), MetatableRef(LUA_NOREF), Env(Env), FunctionCollection(nullptr)
 {
     RawStructPtr = InStruct;
     bIsScriptStruct = InStruct->IsA(UScriptStruct::StaticClass());
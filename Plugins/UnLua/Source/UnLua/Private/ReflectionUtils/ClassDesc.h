@@ -73,6 +73,10 @@ public:
 
     FORCEINLINE uint8 GetUserdataPadding() const { return UserdataPadding; }
 
+    FORCEINLINE int32 GetMetatableRef() const { return MetatableRef; }
+
+    FORCEINLINE void SetMetatableRef(int32 Ref) { MetatableRef = Ref; }
+
     FORCEINLINE TSharedPtr<FPropertyDesc> GetProperty(int32 Index) { return Index > INDEX_NONE && Index < Properties.Num() ? Properties[Index] : nullptr; }
 
     FORCEINLINE TSharedPtr<FFunctionDesc> GetFunction(int32 Index) { return Index > INDEX_NONE && Index < Functions.Num() ? Functions[Index] : nullptr; }
@@ -99,6 +103,8 @@ private:
     int32 UserdataPadding : 8;            // only used for UScriptStruct
     int32 Size : 24;
 
+    int32 MetatableRef;                   // registry ref of the metatable, pinned by FClassRegistry
+
     TMap<FName, TSharedPtr<FFieldDesc>> Fields;
     TArray<TSharedPtr<FPropertyDesc>> Properties;
     TArray<TSharedPtr<FFunctionDesc>> Functions;
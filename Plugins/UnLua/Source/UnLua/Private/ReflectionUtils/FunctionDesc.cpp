@@ -23,14 +23,13 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "LuaDeadLoopCheck.h"
-#include "Containers/StaticBitArray.h"
 
 /**
  * Function descriptor constructor
  */
 FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefaultParams)
     : DefaultParams(InDefaultParams), ReturnPropertyIndex(INDEX_NONE), LatentPropertyIndex(INDEX_NONE)
-    , bStaticFunc(false), bInterfaceFunc(false)
+    , bStaticFunc(false), bInterfaceFunc(false), bAlwaysLocal(false), NextInterfaceCacheEntry(0)
 {
     check(InFunction);
 
@@ -48,6 +47,9 @@ FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefa
     const auto OuterClass = Cast<UClass>(InFunction->GetOuter());
     bInterfaceFunc = OuterClass && OuterClass->HasAnyClassFlags(CLASS_Interface) && OuterClass != UInterface::StaticClass();
 
+    // functions can only go remote or be absorbed by these flags, skip GetFunctionCallspace for the others
+    bAlwaysLocal = bStaticFunc || !InFunction->HasAnyFunctionFlags(FUNC_Net | FUNC_NetRequest | FUNC_NetResponse | FUNC_BlueprintAuthorityOnly | FUNC_BlueprintCosmetic);
+
     Buffer = FParamBufferFactory::Get(*InFunction);
 
     static const FName NAME_LatentInfo = TEXT("LatentInfo");
@@ -73,14 +75,41 @@ FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefa
             }
         }
     }
+
+    check(Properties.Num() <= sizeof(FFlagArray) * 8);
+    DestructibleMask = 0;
+    ParamPlans.SetNum(Properties.Num());
+    for (int32 i = 0; i < Properties.Num(); ++i)
+    {
+        const auto& PropertyDesc = Properties[i];
+        const auto Property = PropertyDesc->GetProperty();
+        auto& Plan = ParamPlans[i];
+        Plan.Offset = Property->GetOffset_ForInternal();
+        Plan.bOut = PropertyDesc->IsOutParameter();
+        Plan.Kind = GetParamKind(Property);
+        if (Plan.Kind == FParamPlan::EKind::Object && Plan.bOut)
+            Plan.Kind = FParamPlan::EKind::Generic;                     // out objects are copied back to their userdata
+        if (Plan.Kind != FParamPlan::EKind::Generic)
+            Plan.Size = Property->ElementSize;
+
+        if (DefaultParams && !Plan.bOut)
+        {
+            if (const auto DefaultValue = DefaultParams->Parameters.Find(Property->GetFName()))
+                Plan.DefaultValue = *DefaultValue;
+        }
+
+        if (!Property->HasAnyPropertyFlags(CPF_NoDestructor))
+            DestructibleMask |= (FFlagArray)1 << i;
+    }
 }
 
-void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer SelfRef, FFrame& Stack, RESULT_DECL)
+void FFunctionDesc::CallLua(UnLua::FLuaEnv& Env, lua_Integer FunctionRef, lua_Integer SelfRef, FFrame& Stack, RESULT_DECL)
 {
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
     TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FuncName);
 #endif
     
+    const auto L = Env.GetMainState();
     lua_pushcfunction(L, UnLua::ReportLuaCallError);
     check(Function.IsValid());
     lua_rawgeti(L, LUA_REGISTRYINDEX, FunctionRef);
@@ -91,9 +120,15 @@ void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer S
     void* InParms;
     FOutParmRec* OutParms = Stack.OutParms;
     const bool bUnpackParams = Stack.CurrentNativeFunction && Stack.Node != Stack.CurrentNativeFunction;
+    UnLua::FParamBufferArena* Arena;
     if (bUnpackParams)
     {
-        InParms = Buffer->Get();
+        InParms = GetParamBuffer(Env, Arena);
+        if (Arena)
+        {
+            for (const auto& Property : Properties)
+                Property->InitializeValue(InParms);
+        }
 
         FOutParmRec* FirstOut = nullptr;
         FOutParmRec* LastOut = nullptr;
@@ -143,32 +178,40 @@ void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer S
         InParms = Stack.Locals;
     }
 
-    CallLuaInternal(L, InParms , OutParms, RESULT_PARAM);
+    CallLuaInternal(Env, InParms , OutParms, RESULT_PARAM);
 
     if (bUnpackParams && InParms)
-        Buffer->Pop(InParms);
+    {
+        if (Arena)
+        {
+            for (const auto& Property : Properties)
+                Property->DestroyValue(InParms);
+        }
+        PopParamBuffer(Arena, InParms);
+    }
 }
 
-bool FFunctionDesc::CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self)
+bool FFunctionDesc::CallLua(UnLua::FLuaEnv& Env, int32 LuaRef, void* Params, UObject* Self)
 {
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
     TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FuncName);
 #endif
     
+    const auto L = Env.GetMainState();
     bool bOk = PushFunction(L, Self, LuaRef);
     if (!bOk)
         return false;
 
     const bool bHasReturnParam = Function->ReturnValueOffset != MAX_uint16;
     uint8* ReturnValueAddress = bHasReturnParam ? ((uint8*)Params + Function->ReturnValueOffset) : nullptr;
-    bOk = CallLuaInternal(L, Params, nullptr, ReturnValueAddress);
+    bOk = CallLuaInternal(Env, Params, nullptr, ReturnValueAddress);
     return bOk;
 }
 
 /**
  * Call the UFunction
  */
-int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
+int32 FFunctionDesc::CallUE(UnLua::FLuaEnv& Env, lua_State *L, int32 NumParams, void *Userdata)
 {
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
     TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FuncName);
@@ -199,15 +242,21 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     if (UNLIKELY(!CheckObject(Object, Error)))
         return luaL_error(L, TCHAR_TO_UTF8(*Error));
 
-    int32 Callspace = Object->GetFunctionCallspace(Function.Get(), nullptr);
-    bool bRemote = Callspace & FunctionCallspace::Remote;
-    bool bLocal = Callspace & FunctionCallspace::Local;
+    bool bRemote = false;
+    bool bLocal = true;
+    if (!bAlwaysLocal || !IsValid(Object))  // actors pending kill absorb all calls
+    {
+        int32 Callspace = Object->GetFunctionCallspace(Function.Get(), nullptr);
+        bRemote = Callspace & FunctionCallspace::Remote;
+        bLocal = Callspace & FunctionCallspace::Local;
+    }
 
     FFlagArray CleanupFlags;
-    const auto Params = Buffer->Get(); 
+    UnLua::FParamBufferArena* Arena;
+    const auto Params = GetParamBuffer(Env, Arena);
     PreCall(L, NumParams, FirstParamIndex, CleanupFlags, Params, Userdata);      // prepare values of properties
     auto FinalFunction = bInterfaceFunc
-                             ? Object->GetClass()->FindFunctionByName(Function->GetFName())
+                             ? ResolveInterfaceFunction(Object->GetClass())
                              : Function.Get();
 
 #if ENABLE_CALL_OVERRIDDEN_FUNCTION
@@ -232,7 +281,39 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     }
 
     int32 NumReturnValues = PostCall(L, NumParams, FirstParamIndex, Params, CleanupFlags);      // push 'out' properties to Lua stack
-    Buffer->Pop(Params);
+    PopParamBuffer(Arena, Params);
+    return NumReturnValues;
+}
+
+/**
+ * Call the static UFunction
+ */
+int32 FFunctionDesc::CallStaticUE(UnLua::FLuaEnv& Env, lua_State *L, int32 NumParams)
+{
+#if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FuncName);
+#endif
+
+    check(bStaticFunc && !IsLatentFunction());
+
+    // the CDO lives as long as its class, static functions are never remote
+    UObject* Object = Function->GetOuterUClass()->GetDefaultObject();
+
+    FFlagArray CleanupFlags;
+    UnLua::FParamBufferArena* Arena;
+    const auto Params = GetParamBuffer(Env, Arena);
+    PreCall(L, NumParams, 1, CleanupFlags, Params);
+    auto FinalFunction = Function.Get();
+
+#if ENABLE_CALL_OVERRIDDEN_FUNCTION
+    const auto LuaFunction = ULuaFunction::Get(FinalFunction);
+    if (LuaFunction && LuaFunction->GetOverridden())
+        FinalFunction = LuaFunction->GetOverridden();
+#endif
+
+    Object->UObject::ProcessEvent(FinalFunction, Params);
+    int32 NumReturnValues = PostCall(L, NumParams, 1, Params, CleanupFlags);
+    PopParamBuffer(Arena, Params);
     return NumReturnValues;
 }
 
@@ -247,11 +328,12 @@ int32 FFunctionDesc::ExecuteDelegate(lua_State *L, int32 NumParams, int32 FirstP
     }
 
     FFlagArray CleanupFlags;
-    const auto Params = Buffer->Get();
+    UnLua::FParamBufferArena* Arena;
+    const auto Params = GetParamBuffer(UnLua::FLuaEnv::FindEnvChecked(L), Arena);
     PreCall(L, NumParams, FirstParamIndex, CleanupFlags, Params);
     ScriptDelegate->ProcessDelegate<UObject>(Params);
     int32 NumReturnValues = PostCall(L, NumParams, FirstParamIndex, Params, CleanupFlags);
-    Buffer->Pop(Params);
+    PopParamBuffer(Arena, Params);
     return NumReturnValues;
 }
 
@@ -266,11 +348,12 @@ void FFunctionDesc::BroadcastMulticastDelegate(lua_State *L, int32 NumParams, in
     }
 
     FFlagArray CleanupFlags;
-    const auto Params = Buffer->Get();
+    UnLua::FParamBufferArena* Arena;
+    const auto Params = GetParamBuffer(UnLua::FLuaEnv::FindEnvChecked(L), Arena);
     PreCall(L, NumParams, FirstParamIndex, CleanupFlags, Params);
     ScriptDelegate->ProcessMulticastDelegate<UObject>(Params);
     PostCall(L, NumParams, FirstParamIndex, Params, CleanupFlags);      // !!! have no return values for multi-cast delegates
-    Buffer->Pop(Params);
+    PopParamBuffer(Arena, Params);
 }
 
 /**
@@ -278,9 +361,48 @@ void FFunctionDesc::BroadcastMulticastDelegate(lua_State *L, int32 NumParams, in
  */
 void FFunctionDesc::PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Params, void* Userdata)
 {
+    CleanupFlags = 0;
     int32 ParamIndex = 0;
     for (int32 i = 0; i < Properties.Num(); ++i)
     {
+        const auto& Plan = ParamPlans[i];
+        if (Plan.Kind != FParamPlan::EKind::Generic)
+        {
+            // primitives are zero constructed and never copied back
+            void* ValuePtr = (uint8*)Params + Plan.Offset;
+            if (i == ReturnPropertyIndex)
+            {
+                FMemory::Memzero(ValuePtr, Plan.Size);
+                CleanupFlags |= (FFlagArray)1 << i;
+                continue;
+            }
+
+            if (ParamIndex < NumParams)
+            {
+                const int32 IndexInStack = FirstParamIndex + ParamIndex;
+#if ENABLE_TYPE_CHECK == 1
+                FString ErrorMsg = "";
+                if (!IsPrimitiveTypeMatched(L, Plan.Kind, IndexInStack) && !Properties[i]->CheckPropertyType(L, IndexInStack, ErrorMsg))
+                {
+                    FMemory::Memzero(ValuePtr, Plan.Size);
+                    UNLUA_LOGERROR(L, LogUnLua, Error, TEXT("Invalid parameter type calling ufunction : %s,parameter : %d, error msg : %s"), *FuncName, ParamIndex, *ErrorMsg);
+                }
+                else
+#endif
+                WritePrimitive(L, Plan, ValuePtr, IndexInStack);
+            }
+            else if (Plan.DefaultValue)
+            {
+                FMemory::Memcpy(ValuePtr, Plan.DefaultValue->GetValue(), Plan.Size);
+            }
+            else
+            {
+                FMemory::Memzero(ValuePtr, Plan.Size);
+            }
+            ++ParamIndex;
+            continue;
+        }
+
         const auto& Property = Properties[i];
         Property->InitializeValue(Params);
         if (i == LatentPropertyIndex)
@@ -303,32 +425,30 @@ void FFunctionDesc::PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex
         }
         if (i == ReturnPropertyIndex)
         {
-            CleanupFlags[i] = ParamIndex >= NumParams || !Property->CopyBack(L, FirstParamIndex + ParamIndex, Params);
+            if (ParamIndex >= NumParams || !Property->CopyBack(L, FirstParamIndex + ParamIndex, Params))
+                CleanupFlags |= (FFlagArray)1 << i;
             continue;
         }
         if (ParamIndex < NumParams)
         {   
 #if ENABLE_TYPE_CHECK == 1
             FString ErrorMsg = "";
-            if (Property->CheckPropertyType(L, FirstParamIndex + ParamIndex, ErrorMsg))
-                CleanupFlags[i] = Property->WriteValue_InContainer(L, Params, FirstParamIndex + ParamIndex, false);
-            else
+            if (!Property->CheckPropertyType(L, FirstParamIndex + ParamIndex, ErrorMsg))
                 UNLUA_LOGERROR(L, LogUnLua, Error, TEXT("Invalid parameter type calling ufunction : %s,parameter : %d, error msg : %s"), *FuncName, ParamIndex, *ErrorMsg);
-#else
-            CleanupFlags[i] = Property->WriteValue_InContainer(L, Params, FirstParamIndex + ParamIndex, false);
+            else
 #endif
+            if (Property->WriteValue_InContainer(L, Params, FirstParamIndex + ParamIndex, false))
+                CleanupFlags |= (FFlagArray)1 << i;
         }
         else if (!Property->IsOutParameter())
         {
             if (DefaultParams)
             {
                 // set value for default parameter
-                IParamValue **DefaultValue = DefaultParams->Parameters.Find(Property->GetProperty()->GetFName());
-                if (DefaultValue)
+                if (Plan.DefaultValue)
                 {
-                    const void *ValuePtr = (*DefaultValue)->GetValue();
-                    Property->CopyValue(Params, ValuePtr);
-                    CleanupFlags[i] = true;
+                    Property->CopyValue(Params, Plan.DefaultValue->GetValue());
+                    CleanupFlags |= (FFlagArray)1 << i;
                 }
             }
             else
@@ -356,6 +476,14 @@ int32 FFunctionDesc::PostCall(lua_State * L, int32 NumParams, int32 FirstParamIn
 #if UNLUA_LEGACY_RETURN_ORDER
     for (int32 Index : OutPropertyIndices)
     {
+        const auto& Plan = ParamPlans[Index];
+        if (Plan.Kind != FParamPlan::EKind::Generic)
+        {
+            PushPrimitive(L, Plan, (uint8*)Params + Plan.Offset);
+            ++NumReturnValues;
+            continue;
+        }
+
         const auto& Property = Properties[Index];
         if (Index >= NumParams || !Property->CopyBack(L, Params, FirstParamIndex + Index))
         {
@@ -368,7 +496,12 @@ int32 FFunctionDesc::PostCall(lua_State * L, int32 NumParams, int32 FirstParamIn
     if (ReturnPropertyIndex > INDEX_NONE)
     {
         const auto& Property = Properties[ReturnPropertyIndex];
-        if (CleanupFlags[ReturnPropertyIndex])
+        const auto& Plan = ParamPlans[ReturnPropertyIndex];
+        if (Plan.Kind != FParamPlan::EKind::Generic)
+        {
+            PushPrimitive(L, Plan, (uint8*)Params + Plan.Offset);
+        }
+        else if (CleanupFlags & ((FFlagArray)1 << ReturnPropertyIndex))
         {
             Property->ReadValue_InContainer(L, Params, true);
         }
@@ -389,6 +522,14 @@ int32 FFunctionDesc::PostCall(lua_State * L, int32 NumParams, int32 FirstParamIn
     // c++ may has return and out params, we must push it on stack
     for (int32 Index : OutPropertyIndices)
     {
+        const auto& Plan = ParamPlans[Index];
+        if (Plan.Kind != FParamPlan::EKind::Generic)
+        {
+            PushPrimitive(L, Plan, (uint8*)Params + Plan.Offset);
+            ++NumReturnValues;
+            continue;
+        }
+
         const auto& Property = Properties[Index];
         if (Index >= NumParams || !Property->CopyBack(L, Params, FirstParamIndex + Index))
         {
@@ -398,9 +539,10 @@ int32 FFunctionDesc::PostCall(lua_State * L, int32 NumParams, int32 FirstParamIn
     }
 #endif
 
-    for (int32 i = 0; i < Properties.Num(); ++i)
+    FFlagArray DestroyFlags = CleanupFlags & DestructibleMask;
+    for (int32 i = 0; DestroyFlags; ++i, DestroyFlags >>= 1)
     {
-        if (CleanupFlags[i])
+        if (DestroyFlags & 1)
         {
             Properties[i]->DestroyValue(Params);
         }
@@ -428,15 +570,16 @@ static FOutParmRec* FindOutParmRec(FOutParmRec *OutParam, FProperty *OutProperty
 /**
  * Call Lua function that overrides this UFunction. 
  */
-bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const
+bool FFunctionDesc::CallLuaInternal(UnLua::FLuaEnv& Env, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const
 {
+    const auto L = Env.GetMainState();
+
     // -1 = [table/userdata] UObject for self
     // -2 = [function] to call
     // -3 = [function] ReportLuaCallError
     const auto ErrorHandlerIndex = lua_gettop(L) - 2;
 
-    const auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
-    const auto DanglingGuard = Env.GetDanglingCheck()->MakeGuard();
+    const UnLua::FDanglingCheck::FGuard DanglingGuard(Env.GetDanglingCheck());
 
     if (InParams)
     {
@@ -455,7 +598,8 @@ bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *O
     if (ReturnPropertyIndex == INDEX_NONE)
         NumParams++;
 
-    const auto Guard = Env.GetDeadLoopCheck()->MakeGuard();
+    const UnLua::FDeadLoopCheck::FGuard Guard(Env.GetDeadLoopCheck());
+    const UnLua::FParamBufferArena::FGuard ArenaGuard(Env.GetParamBufferArena());
     if (lua_pcall(L, NumParams, LUA_MULTRET, -(NumParams + 2)) != LUA_OK)
     {
         lua_settop(L, ErrorHandlerIndex - 1);
@@ -527,6 +671,203 @@ bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *O
     return true;
 }
 
+UFunction* FFunctionDesc::ResolveInterfaceFunction(UClass* Class)
+{
+    for (const auto& Entry : InterfaceCache)
+    {
+        if (Entry.Class.Get() == Class)
+        {
+            if (const auto Cached = Entry.Function.Get())
+                return Cached;
+        }
+    }
+
+    const auto Resolved = Class->FindFunctionByName(Function->GetFName());
+    auto& Entry = InterfaceCache[NextInterfaceCacheEntry];
+    Entry.Class = Class;
+    Entry.Function = Resolved;
+    NextInterfaceCacheEntry = (NextInterfaceCacheEntry + 1) % InterfaceCacheSize;
+    return Resolved;
+}
+
+void* FFunctionDesc::GetParamBuffer(const UnLua::FLuaEnv& Env, UnLua::FParamBufferArena*& OutArena) const
+{
+    OutArena = Env.GetParamBufferArena();
+    if (ParmsSize > 0 && OutArena->IsEnabled())
+        return OutArena->Push(ParmsSize); // every property is initialized before use, so nothing to zero here
+
+    OutArena = nullptr;
+    return Buffer->Get();
+}
+
+void FFunctionDesc::PopParamBuffer(UnLua::FParamBufferArena* Arena, void* Params) const
+{
+    if (Arena)
+        Arena->Pop(Params);
+    else
+        Buffer->Pop(Params);
+}
+
+FFunctionDesc::FParamPlan::EKind FFunctionDesc::GetParamKind(const FProperty* Property)
+{
+    if (Property->ArrayDim != 1)
+        return FParamPlan::EKind::Generic;
+
+    if (const auto EnumProperty = CastField<FEnumProperty>(Property))
+        return GetParamKind(EnumProperty->GetUnderlyingProperty());
+
+    if (const auto BoolProperty = CastField<FBoolProperty>(Property))
+        return BoolProperty->IsNativeBool() ? FParamPlan::EKind::Bool : FParamPlan::EKind::Generic;
+
+    if (CastField<FClassProperty>(Property))
+        return FParamPlan::EKind::Generic;                              // classes are checked against meta class
+
+    switch (GetPropertyType(Property))
+    {
+    case CPT_Int8:
+        return FParamPlan::EKind::Int8;
+    case CPT_Int16:
+        return FParamPlan::EKind::Int16;
+    case CPT_Int:
+        return FParamPlan::EKind::Int32;
+    case CPT_Int64:
+        return FParamPlan::EKind::Int64;
+    case CPT_Byte:
+        return FParamPlan::EKind::UInt8;
+    case CPT_UInt16:
+        return FParamPlan::EKind::UInt16;
+    case CPT_UInt32:
+        return FParamPlan::EKind::UInt32;
+    case CPT_UInt64:
+        return FParamPlan::EKind::UInt64;
+    case CPT_Float:
+        return FParamPlan::EKind::Float;
+    case CPT_Double:
+        return FParamPlan::EKind::Double;
+    case CPT_ObjectReference:
+        return FParamPlan::EKind::Object;
+    default:
+        return FParamPlan::EKind::Generic;
+    }
+}
+
+#if ENABLE_TYPE_CHECK == 1
+bool FFunctionDesc::IsPrimitiveTypeMatched(lua_State* L, FParamPlan::EKind Kind, int32 IndexInStack)
+{
+    const int32 Type = lua_type(L, IndexInStack);
+    if (Type == LUA_TNIL)
+        return true;
+
+    switch (Kind)
+    {
+    case FParamPlan::EKind::Float:
+    case FParamPlan::EKind::Double:
+        return Type == LUA_TNUMBER;
+    case FParamPlan::EKind::Bool:
+        return Type == LUA_TBOOLEAN;
+    case FParamPlan::EKind::Object:
+        return false;
+    default:
+        return Type == LUA_TNUMBER && lua_isinteger(L, IndexInStack);
+    }
+}
+#endif
+
+void FFunctionDesc::WritePrimitive(lua_State* L, const FParamPlan& Plan, void* ValuePtr, int32 IndexInStack)
+{
+    switch (Plan.Kind)
+    {
+    case FParamPlan::EKind::Int8:
+        *(int8*)ValuePtr = (int8)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::Int16:
+        *(int16*)ValuePtr = (int16)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::Int32:
+        *(int32*)ValuePtr = (int32)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::Int64:
+        *(int64*)ValuePtr = (int64)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::UInt8:
+        *(uint8*)ValuePtr = (uint8)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::UInt16:
+        *(uint16*)ValuePtr = (uint16)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::UInt32:
+        *(uint32*)ValuePtr = (uint32)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::UInt64:
+        *(uint64*)ValuePtr = (uint64)lua_tointeger(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::Float:
+        *(float*)ValuePtr = (float)lua_tonumber(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::Double:
+        *(double*)ValuePtr = (double)lua_tonumber(L, IndexInStack);
+        break;
+    case FParamPlan::EKind::Bool:
+        *(bool*)ValuePtr = lua_toboolean(L, IndexInStack) != 0;
+        break;
+    case FParamPlan::EKind::Object:
+        {
+            UObject* Object = UnLua::GetUObject(L, IndexInStack, false);
+            if (UnLua::LowLevel::IsReleasedPtr(Object))
+            {
+                UNLUA_LOGWARNING(L, LogUnLua, Warning, TEXT("attempt to set parameter with released object"));
+                Object = nullptr;
+            }
+            *(UObject**)ValuePtr = Object;
+            break;
+        }
+    default:
+        checkNoEntry();
+    }
+}
+
+void FFunctionDesc::PushPrimitive(lua_State* L, const FParamPlan& Plan, const void* ValuePtr)
+{
+    switch (Plan.Kind)
+    {
+    case FParamPlan::EKind::Int8:
+        lua_pushinteger(L, *(const int8*)ValuePtr);
+        break;
+    case FParamPlan::EKind::Int16:
+        lua_pushinteger(L, *(const int16*)ValuePtr);
+        break;
+    case FParamPlan::EKind::Int32:
+        lua_pushinteger(L, *(const int32*)ValuePtr);
+        break;
+    case FParamPlan::EKind::Int64:
+        lua_pushinteger(L, *(const int64*)ValuePtr);
+        break;
+    case FParamPlan::EKind::UInt8:
+        lua_pushinteger(L, *(const uint8*)ValuePtr);
+        break;
+    case FParamPlan::EKind::UInt16:
+        lua_pushinteger(L, *(const uint16*)ValuePtr);
+        break;
+    case FParamPlan::EKind::UInt32:
+        lua_pushinteger(L, *(const uint32*)ValuePtr);
+        break;
+    case FParamPlan::EKind::UInt64:
+        lua_pushinteger(L, (lua_Integer)*(const uint64*)ValuePtr);
+        break;
+    case FParamPlan::EKind::Float:
+        lua_pushnumber(L, *(const float*)ValuePtr);
+        break;
+    case FParamPlan::EKind::Double:
+        lua_pushnumber(L, *(const double*)ValuePtr);
+        break;
+    case FParamPlan::EKind::Bool:
+        lua_pushboolean(L, *(const bool*)ValuePtr);
+        break;
+    default:
+        checkNoEntry();                                                 // out objects are always generic
+    }
+}
+
 bool FFunctionDesc::CheckObject(UObject* Object, FString& Error) const
 {
     if (Object == UnLua::LowLevel::ReleasedPtr)
@@ -14,13 +14,14 @@
 
 #pragma once
 
-#include "Containers/StaticBitArray.h"
 #include "lua.hpp"
+#include "LuaParamBufferArena.h"
 #include "ParamBufferAllocator.h"
 #include "Registries/FunctionRegistry.h"
 #include "ReflectionUtils/PropertyDesc.h"
 
 struct FParameterCollection;
+class IParamValue;
 
 /**
  * Function descriptor
@@ -51,6 +52,13 @@ public:
      */
     FORCEINLINE bool IsLatentFunction() const { return LatentPropertyIndex > INDEX_NONE; }
 
+    /**
+     * Test if this function is a static function, e.g. functions of UBlueprintFunctionLibrary
+     *
+     * @return - true if the function is a static function, false otherwise
+     */
+    FORCEINLINE bool IsStaticFunction() const { return bStaticFunc; }
+
     /**
      * Get the number of out properties
      *
@@ -74,18 +82,28 @@ public:
 
     FORCEINLINE const char* GetLuaFunctionName() const { return LuaFunctionName->Get(); }
  
-    void CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer SelfRef, FFrame& Stack, RESULT_DECL);
+    void CallLua(UnLua::FLuaEnv& Env, lua_Integer FunctionRef, lua_Integer SelfRef, FFrame& Stack, RESULT_DECL);
  
-    bool CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self);
+    bool CallLua(UnLua::FLuaEnv& Env, int32 LuaRef, void* Params, UObject* Self);
  
     /**
      * Call this UFunction
      *
+     * @param Env - the env owning the lua state
      * @param NumParams - the number of parameters
      * @param Userdata - user data, now it's only used for latent function and it must be a 'int32'
      * @return - the number of return values pushed on the stack
      */
-    int32 CallUE(lua_State *L, int32 NumParams, void *Userdata = nullptr);
+    int32 CallUE(UnLua::FLuaEnv& Env, lua_State *L, int32 NumParams, void *Userdata = nullptr);
+
+    /**
+     * Call this static UFunction on the CDO of its class, object validation and callspace checks are skipped
+     *
+     * @param Env - the env owning the lua state
+     * @param NumParams - the number of parameters
+     * @return - the number of return values pushed on the stack
+     */
+    int32 CallStaticUE(UnLua::FLuaEnv& Env, lua_State *L, int32 NumParams);
 
     /**
      * Fire the delegate
@@ -107,24 +125,96 @@ public:
     void BroadcastMulticastDelegate(lua_State *L, int32 NumParams, int32 FirstParamIndex, FMulticastScriptDelegate *ScriptDelegate);
 
 private:
-    typedef TStaticBitArray<64U> FFlagArray;
+    typedef uint64 FFlagArray; // bit per parameter, set if the value needs cleanup after the call
+
+    /**
+     * Flat marshalling plan of a parameter, built on registration so primitives are marshalled without virtual calls
+     */
+    struct FParamPlan
+    {
+        enum class EKind : uint8
+        {
+            Generic,    // marshalled by FPropertyDesc
+            Int8,
+            Int16,
+            Int32,
+            Int64,
+            UInt8,
+            UInt16,
+            UInt32,
+            UInt64,
+            Float,
+            Double,
+            Bool,
+            Object,
+        };
+
+        IParamValue* DefaultValue = nullptr;    // default value of the parameter, nullptr if none
+        uint16 Offset = 0;
+        uint8 Size = 0;
+        EKind Kind = EKind::Generic;
+        bool bOut = false;                      // return parameter or non-const reference parameter
+    };
+
+    static FParamPlan::EKind GetParamKind(const FProperty* Property);
+
+#if ENABLE_TYPE_CHECK == 1
+    /**
+     * Quick type check of primitives, objects and mismatches fall back to FPropertyDesc::CheckPropertyType for messages
+     */
+    static FORCEINLINE bool IsPrimitiveTypeMatched(lua_State* L, FParamPlan::EKind Kind, int32 IndexInStack);
+#endif
+
+    static FORCEINLINE void WritePrimitive(lua_State* L, const FParamPlan& Plan, void* ValuePtr, int32 IndexInStack);
+
+    static FORCEINLINE void PushPrimitive(lua_State* L, const FParamPlan& Plan, const void* ValuePtr);
+
     void PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Params, void* Userdata = nullptr);
     int32 PostCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, void* Params, const FFlagArray& CleanupFlags);
 
-    bool CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const;
+    bool CallLuaInternal(UnLua::FLuaEnv& Env, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const;
 
     FORCEINLINE bool CheckObject(UObject* Object, FString& Error) const;
 
+    /**
+     * Get a parameter buffer from the arena of the env if it is enabled, or from the allocator of this function.
+     * Arena buffers are left uninitialized, every property must be constructed in place.
+     */
+    FORCEINLINE void* GetParamBuffer(const UnLua::FLuaEnv& Env, UnLua::FParamBufferArena*& OutArena) const;
+
+    FORCEINLINE void PopParamBuffer(UnLua::FParamBufferArena* Arena, void* Params) const;
+
+    /**
+     * Find the implementation of the interface function in the class of the object
+     */
+    UFunction* ResolveInterfaceFunction(UClass* Class);
+
+    /**
+     * Resolved interface functions of recently called classes
+     */
+    struct FInterfaceCacheEntry
+    {
+        TWeakObjectPtr<UClass> Class;
+        TWeakObjectPtr<UFunction> Function; // weak too, blueprint recompiling may replace functions of a class
+    };
+
+    static constexpr int32 InterfaceCacheSize = 4;
+
     TWeakObjectPtr<UFunction> Function;
     FString FuncName;
     TSharedPtr<FParamBufferAllocator> Buffer;
     TArray<TUniquePtr<FPropertyDesc>> Properties;
+    TArray<FParamPlan> ParamPlans; // parallel to Properties
+    FFlagArray DestructibleMask; // parameters with destructors
     TArray<int32> OutPropertyIndices;
     FParameterCollection *DefaultParams;
     int32 ReturnPropertyIndex;
     int32 LatentPropertyIndex;
     uint8 bStaticFunc : 1;
     uint8 bInterfaceFunc : 1;
+    uint8 bAlwaysLocal : 1;
+    uint8 NextInterfaceCacheEntry;
+    FInterfaceCacheEntry InterfaceCache[InterfaceCacheSize];
     int32 ParmsSize;
     TUniquePtr<FTCHARToUTF8> LuaFunctionName;
 };
@@ -598,13 +598,13 @@ public:
         }
         else
         {
-            lua_pushstring(L, TCHAR_TO_UTF8(*NameProperty->GetPropertyValue(ValuePtr).ToString()));
+            UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->Push(L, NameProperty->GetPropertyValue(ValuePtr));
         }
     }
 
     virtual bool SetValueInternal(lua_State *L, void *ValuePtr, int32 IndexInStack, bool bCopyValue) const override
     {
-        NameProperty->SetPropertyValue(ValuePtr, FName(UTF8_TO_TCHAR(lua_tostring(L, IndexInStack))));
+        NameProperty->SetPropertyValue(ValuePtr, UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->ToName(L, IndexInStack));
         return true;
     }
 
@@ -642,13 +642,13 @@ public:
         }
         else
         {
-            lua_pushstring(L, TCHAR_TO_UTF8(*StringProperty->GetPropertyValue(ValuePtr)));
+            UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->Push(L, StringProperty->GetPropertyValue(ValuePtr));
         }
     }
 
     virtual bool SetValueInternal(lua_State *L, void *ValuePtr, int32 IndexInStack, bool bCopyValue) const override
     {
-        StringProperty->SetPropertyValue(ValuePtr, UTF8_TO_TCHAR(lua_tostring(L, IndexInStack)));
+        StringProperty->SetPropertyValue(ValuePtr, UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->ToString(L, IndexInStack));
         return true;
     }
 
@@ -785,7 +785,8 @@ public:
         {
             FScriptArray ScriptArray;
             FLuaArray LuaArray(&ScriptArray, InnerProperty, FLuaArray::OwnedByOther);
-            TraverseTable(L, IndexInStack, &LuaArray, FArrayPropertyDesc::FillArray);       // fill table elements
+            if (!LuaArray.AppendTable(L, IndexInStack))                                     // sequences of primitives in bulk
+                TraverseTable(L, IndexInStack, &LuaArray, FArrayPropertyDesc::FillArray);   // fill table elements
             ArrayProperty->CopyCompleteValue(ValuePtr, &ScriptArray);
         }
         else if (Type == LUA_TUSERDATA)
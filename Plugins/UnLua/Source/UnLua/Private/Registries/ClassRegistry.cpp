@@ -62,6 +62,7 @@ namespace UnLua
         if (Ret)
         {
             Classes.FindOrAdd(Ret->AsStruct(), Ret);
+            Env->GetTouchedObjects()->Mark(Ret->AsStruct());
             return Ret;
         }
 
@@ -98,6 +99,7 @@ namespace UnLua
         if (Exists)
         {
             Classes.Add(Type, *Exists);
+            Env->GetTouchedObjects()->Mark(Type);
             return *Exists;
         }
 
@@ -118,6 +120,8 @@ namespace UnLua
             }
             else
             {
+                if (Ret && Ret->GetMetatableRef() == LUA_NOREF)
+                    PinMetatable(L, Ret);
                 return true;
             }
         }
@@ -212,6 +216,8 @@ namespace UnLua
         lua_pushvalue(L, -1); // set metatable to self
         lua_setmetatable(L, -2);
 
+        PinMetatable(L, ClassDesc);
+
         TArray<FClassDesc*> ClassDescChain;
         ClassDescChain.Add(ClassDesc);
 
@@ -244,6 +250,37 @@ namespace UnLua
         return true;
     }
 
+    bool FClassRegistry::PushMetatable(lua_State* L, const UStruct* Type)
+    {
+        const auto ClassDesc = Find(Type);
+        if (ClassDesc && ClassDesc->GetMetatableRef() != LUA_NOREF && ClassDesc->IsStructValid())
+        {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, ClassDesc->GetMetatableRef());
+            return true;
+        }
+
+        const auto MetatableName = LowLevel::GetMetatableName(Type);
+        if (MetatableName.IsEmpty())
+            return false;
+        return PushMetatable(L, TCHAR_TO_UTF8(*MetatableName));
+    }
+
+    bool FClassRegistry::TrySetMetatable(lua_State* L, const UStruct* Type)
+    {
+        if (!PushMetatable(L, Type))
+            return false;
+
+        lua_setmetatable(L, -2);
+        return true;
+    }
+
+    void FClassRegistry::ResetMetatableRefs()
+    {
+        const auto L = Env->GetMainState();
+        for (const auto Pair : Name2Classes)
+            UnpinMetatable(L, Pair.Value);
+    }
+
     FClassDesc* FClassRegistry::Register(const char* MetatableName)
     {
         const auto L = Env->GetMainState();
@@ -322,17 +359,35 @@ namespace UnLua
         FClassDesc* ClassDesc = new FClassDesc(Env, Type, Name);
         Classes.Add(Type, ClassDesc);
         Name2Classes.Add(FName(*Name), ClassDesc);
+        Env->GetTouchedObjects()->Mark(Type);
 
         return ClassDesc;
     }
 
-    void FClassRegistry::Unregister(const FClassDesc* ClassDesc, const bool bForce)
+    void FClassRegistry::Unregister(FClassDesc* ClassDesc, const bool bForce)
     {
         if (ClassDesc->IsStructValid() && !bForce)
             return;
         const auto L = Env->GetMainState();
         const auto MetatableName = ClassDesc->GetName();
+        UnpinMetatable(L, ClassDesc);
         lua_pushnil(L);
         lua_setfield(L, LUA_REGISTRYINDEX, TCHAR_TO_UTF8(*MetatableName));
     }
+
+    void FClassRegistry::PinMetatable(lua_State* L, FClassDesc* ClassDesc)
+    {
+        UnpinMetatable(L, ClassDesc);
+        lua_pushvalue(L, -1);
+        ClassDesc->SetMetatableRef(luaL_ref(L, LUA_REGISTRYINDEX));
+    }
+
+    void FClassRegistry::UnpinMetatable(lua_State* L, FClassDesc* ClassDesc)
+    {
+        const auto Ref = ClassDesc->GetMetatableRef();
+        if (Ref == LUA_NOREF)
+            return;
+        luaL_unref(L, LUA_REGISTRYINDEX, Ref);
+        ClassDesc->SetMetatableRef(LUA_NOREF);
+    }
 }
@@ -44,8 +44,20 @@ namespace UnLua
 
         bool PushMetatable(lua_State* L, const char* MetatableName);
 
+        /**
+         * Push metatable by the registry ref cached on class descriptor, fallback to name lookup on miss.
+         */
+        bool PushMetatable(lua_State* L, const UStruct* Type);
+
         bool TrySetMetatable(lua_State* L, const char* MetatableName);
 
+        bool TrySetMetatable(lua_State* L, const UStruct* Type);
+
+        /**
+         * Release all cached metatable refs, they will be pinned again on next push.
+         */
+        void ResetMetatableRefs();
+
         FClassDesc* Register(const char* MetatableName);
 
         FClassDesc* Register(const UStruct* Class);
@@ -57,7 +69,11 @@ namespace UnLua
     private:
         FClassDesc* RegisterInternal(UStruct* Type, const FString& Name);
 
-        void Unregister(const FClassDesc* ClassDesc, const bool bForce);
+        void Unregister(FClassDesc* ClassDesc, const bool bForce);
+
+        void PinMetatable(lua_State* L, FClassDesc* ClassDesc);
+
+        void UnpinMetatable(lua_State* L, FClassDesc* ClassDesc);
 
         TMap<UStruct*, FClassDesc*> Classes;
         TMap<FName, FClassDesc*> Name2Classes;
@@ -22,13 +22,7 @@ namespace UnLua
     FContainerRegistry::FContainerRegistry(FLuaEnv* Env)
         : Env(Env)
     {
-        // <FScriptArray, FLuaArray/FLuaMap/FLuaSet>
-        const auto L = Env->GetMainState();
-        lua_pushstring(L, "ScriptContainerMap");
-        LowLevel::CreateWeakValueTable(L);
-        lua_pushvalue(L, -1);
-        MapRef = luaL_ref(L, -1);
-        lua_rawset(L, LUA_REGISTRYINDEX);
+        // <FScriptArray, FLuaArray/FLuaMap/FLuaSet> cached in ERegistryTable::ScriptContainerMap
     }
 
     FLuaArray* FContainerRegistry::NewArray(lua_State* L, TSharedPtr<ITypeInterface> ElementType, FLuaArray::EScriptArrayFlag Flag)
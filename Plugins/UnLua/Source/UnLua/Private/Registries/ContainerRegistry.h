@@ -50,7 +50,6 @@ namespace UnLua
     private:
         static void* NewUserdata(lua_State* L, const FScriptContainerDesc& Desc);
 
-        int MapRef;
         FLuaEnv* Env;
     };
 }
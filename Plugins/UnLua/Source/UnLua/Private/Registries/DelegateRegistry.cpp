@@ -16,6 +16,7 @@
 #include "LuaDelegateHandler.h"
 #include "ObjectReferencer.h"
 #include "LuaEnv.h"
+#include "UnLuaBase.h"
 
 namespace UnLua
 {
@@ -35,51 +36,70 @@ namespace UnLua
             ToRelease->Reset();
             Env->AutoObjectReference.Remove(ToRelease);
         }
+        for (const auto Handler : PooledHandlers)
+            Env->AutoObjectReference.Remove(Handler);
         Delegates.Empty();
         FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
     }
 
     void FDelegateRegistry::OnPostGarbageCollect()
     {
-        TArray<TTuple<void*, FDelegateInfo>> InvalidPairs;
-        for (auto& Pair : Delegates)
-        {
-            if (!Pair.Value.Owner.IsValid())
-                InvalidPairs.Add(Pair);
-        }
+        const double StartTime = FPlatformTime::Seconds();
+        int32 Swept = 0;
 
-        for (int i = 0; i < InvalidPairs.Num(); i++)
-        {
-            const auto& Pair = InvalidPairs[i];
-            if (Pair.Value.bIsMulticast)
-                Clear(Pair.Key);
-            else
-                Unbind(Pair.Key);
-            Delegates.Remove(Pair.Key);
-            if (Pair.Value.bDeleteOnRemove)
-                delete (FScriptDelegate*)Pair.Key;
-        }
+        // delegates without owner are out of sight of the delete listener, a bounded number are released per gc
+        int32 Budget = MaxUnownedSweepsPerGC;
+        for (auto It = UnownedDelegates.CreateConstIterator(); It && Budget > 0; ++It, --Budget)
+            PendingDelegates.Add(*It);
 
-        TArray<FLuaDelegatePair> ToRemove;
-        for (auto& Pair : CachedHandlers)
+        for (const auto Delegate : PendingDelegates)
         {
-            if (Pair.Key.SelfObject.IsStale())
-            {
-                ToRemove.Add(Pair.Key);
-                Env->AutoObjectReference.Remove(Pair.Value.Get());
-            }
+            const auto Info = Delegates.Find(Delegate);
+            if (!Info || Info->Owner.IsValid())
+                continue; // removed already or registered again with a new owner
+            RemoveDelegate(Delegate);
+            Swept++;
         }
+        PendingDelegates.Reset();
 
-        for (auto& Key : ToRemove)
+        for (const auto& Key : PendingHandlers)
         {
+            if (!Key.SelfObject.IsStale())
+                continue;
             TWeakObjectPtr<ULuaDelegateHandler> Handler;
-            if (CachedHandlers.RemoveAndCopyValue(Key, Handler))
+            if (CachedHandlers.RemoveAndCopyValue(Key, Handler) && Handler.IsValid())
             {
-                const auto L = Env->GetMainState();
-                luaL_unref(L, LUA_REGISTRYINDEX, Handler->LuaRef);
-                Handler->Reset();
+                ReleaseHandler(Handler.Get());
+                Swept++;
             }
         }
+        PendingHandlers.Reset();
+
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+        Stats.Sweeps++;
+        Stats.LastSwept = Swept;
+        Stats.LastSweepTime = Elapsed;
+        Stats.MaxSweepTime = FMath::Max(Stats.MaxSweepTime, Elapsed);
+    }
+
+    void FDelegateRegistry::NotifyUObjectDeleted(UObject* Object)
+    {
+        const int32 NumDelegates = PendingDelegates.Num();
+        DelegatesByOwner.MultiFind(Object, PendingDelegates);
+        if (PendingDelegates.Num() > NumDelegates)
+            DelegatesByOwner.Remove(Object);
+
+        const int32 NumHandlers = PendingHandlers.Num();
+        HandlersBySelf.MultiFind(Object, PendingHandlers);
+        if (PendingHandlers.Num() > NumHandlers)
+            HandlersBySelf.Remove(Object);
+    }
+
+    void FDelegateRegistry::Report() const
+    {
+        UE_LOG(LogUnLua, Log, TEXT("%s delegate registry: %d handlers, %d pooled, %d links, %d created, %d reused, %d sweeps, last sweep released %d in %.3f ms, max %.3f ms."),
+               *Env->GetName(), Stats.Handlers, Stats.PooledHandlers, Stats.Links, Stats.Created, Stats.Reused, Stats.Sweeps,
+               Stats.LastSwept, Stats.LastSweepTime * 1000, Stats.MaxSweepTime * 1000);
     }
 
     FScriptDelegate* FDelegateRegistry::Register(FScriptDelegate* Delegate, FDelegateProperty* Property)
@@ -92,13 +112,19 @@ namespace UnLua
         NewInfo.SignatureFunction = CastField<FDelegateProperty>(Property)->SignatureFunction;
         NewInfo.bDeleteOnRemove = true;
         NewInfo.bIsMulticast = false;
+        NewInfo.bInStruct = false;
         NewInfo.Owner = nullptr;
         Delegates.Add(Cloned, NewInfo);
+        UnownedDelegates.Add(Cloned);
         return Cloned;
     }
 
     void FDelegateRegistry::NotifyHandlerBeginDestroy(ULuaDelegateHandler* Handler)
     {
+        while (Handler->FirstLink != INDEX_NONE)
+            Unlink(Handler->FirstLink);
+        Stats.Handlers--;
+
         const auto L = Env->GetMainState();
         luaL_unref(L, LUA_REGISTRYINDEX, Handler->LuaRef);
         Handler->Reset();
@@ -138,7 +164,7 @@ namespace UnLua
         if (Info)
         {
             check(Info->Property == Property);
-            Info->Owner = Owner;
+            SetOwner(Delegate, *Info, Owner);
         }
         else
         {
@@ -146,6 +172,7 @@ namespace UnLua
             NewInfo.Property = Property;
             NewInfo.Desc = nullptr;
             NewInfo.bDeleteOnRemove = false;
+            NewInfo.bInStruct = !Cast<UClass>(Property->GetOwnerStruct());
             if (const auto MulticastProperty = CastField<FMulticastDelegateProperty>(Property))
             {
                 NewInfo.SignatureFunction = MulticastProperty->SignatureFunction;
@@ -160,8 +187,7 @@ namespace UnLua
             {
                 check(false);
             }
-            NewInfo.Owner = Owner;
-            Delegates.Add(Delegate, NewInfo);
+            SetOwner(Delegate, Delegates.Add(Delegate, NewInfo), Owner);
         }
     }
 
@@ -171,14 +197,18 @@ namespace UnLua
         const auto LuaFunction = lua_topointer(L, Index);
         auto& Info = Delegates.FindChecked(Delegate);
         if (!Info.Owner.IsValid())
-            Info.Owner = SelfObject;
+            SetOwner(Delegate, Info, SelfObject);
+
+        // binding replaces the previous one
+        UnlinkAll(Info);
 
         const auto DelegatePair = FLuaDelegatePair(SelfObject, LuaFunction);
         const auto Cached = CachedHandlers.Find(DelegatePair);
         if (Cached && Cached->IsValid())
         {
             (*Cached)->BindTo(Delegate);
-            Info.Handlers.Add(*Cached);
+            (*Cached)->bPoolable = false;
+            Link(Delegate, Info, Cached->Get());
             return;
         }
 
@@ -186,9 +216,16 @@ namespace UnLua
         const auto Ref = luaL_ref(L, LUA_REGISTRYINDEX);
         const auto Handler = CreateHandler(Ref, Info.Owner.Get(), SelfObject);
         Handler->BindTo(Delegate);
-        Env->AutoObjectReference.Add(Handler);
+        // single cast delegates are copied by value, e.g. into the timer manager when passed as parameters,
+        // the copies still call this handler after the registered delegate is gone
+        Handler->bPoolable = false;
         CachedHandlers.Add(DelegatePair, Handler);
-        Info.Handlers.Add(Handler);
+        if (SelfObject)
+        {
+            HandlersBySelf.Add(SelfObject, DelegatePair);
+            Env->GetTouchedObjects()->Mark(SelfObject);
+        }
+        Link(Delegate, Info, Handler);
     }
 
     void FDelegateRegistry::Unbind(void* Delegate)
@@ -197,14 +234,9 @@ namespace UnLua
         if (!Info)
             return;
 
-        for (const auto& Handler : Info->Handlers)
-        {
-            if (!Handler.IsValid())
-                continue;
-            if (!Info->Owner.IsStale())
-                ((FScriptDelegate*)Delegate)->Unbind();
-        }
-        Info->Handlers.Empty();
+        if (Info->FirstLink != INDEX_NONE && !Info->Owner.IsStale())
+            ((FScriptDelegate*)Delegate)->Unbind();
+        UnlinkAll(*Info);
     }
 
     void FDelegateRegistry::Execute(const ULuaDelegateHandler* Handler, void* Params)
@@ -216,8 +248,7 @@ namespace UnLua
         if (Handler->SelfObject.IsStale())
             return;
 
-        const auto L = Env->GetMainState();
-        SignatureDesc->CallLua(L, Handler->LuaRef, Params, Handler->SelfObject.Get());
+        SignatureDesc->CallLua(*Env, Handler->LuaRef, Params, Handler->SelfObject.Get());
     }
 
     int32 FDelegateRegistry::Execute(lua_State* L, FScriptDelegate* Delegate, int32 NumParams, int32 FirstParamIndex)
@@ -239,7 +270,7 @@ namespace UnLua
         check(lua_type(L, Index) == LUA_TFUNCTION);
         auto& Info = Delegates.FindChecked(Delegate);
         if (!Info.Owner.IsValid())
-            Info.Owner = SelfObject;
+            SetOwner(Delegate, Info, SelfObject);
 
         const auto LuaFunction = lua_topointer(L, Index);
         const auto DelegatePair = FLuaDelegatePair(SelfObject, LuaFunction);
@@ -248,17 +279,25 @@ namespace UnLua
         {
             CheckSignatureCompatible(L, Cached->Get(), Delegate);
             (*Cached)->AddTo(Info.MulticastProperty, Delegate);
-            Info.Handlers.Add(*Cached);
+            if (Info.bInStruct)
+                (*Cached)->bPoolable = false;
+            Link(Delegate, Info, Cached->Get());
             return;
         }
 
         lua_pushvalue(L, Index);
         const auto Ref = luaL_ref(L, LUA_REGISTRYINDEX);
         const auto Handler = CreateHandler(Ref, Info.Owner.Get(), SelfObject);
-        Env->AutoObjectReference.Add(Handler);
         Handler->AddTo(Info.MulticastProperty, Delegate);
+        if (Info.bInStruct)
+            Handler->bPoolable = false;
         CachedHandlers.Add(DelegatePair, Handler);
-        Info.Handlers.Add(Handler);
+        if (SelfObject)
+        {
+            HandlersBySelf.Add(SelfObject, DelegatePair);
+            Env->GetTouchedObjects()->Mark(SelfObject);
+        }
+        Link(Delegate, Info, Handler);
     }
 
     void FDelegateRegistry::Remove(lua_State* L, UObject* SelfObject, void* Delegate, int Index)
@@ -272,8 +311,11 @@ namespace UnLua
         if (!Cached || !Cached->IsValid())
             return;
 
-        (*Cached)->RemoveFrom(Info.MulticastProperty, Delegate);
-        Info.Handlers.Remove(*Cached);
+        const auto Handler = Cached->Get();
+        Handler->RemoveFrom(Info.MulticastProperty, Delegate);
+        const int32 LinkIndex = FindLink(Delegate, Handler);
+        if (LinkIndex != INDEX_NONE)
+            Unlink(LinkIndex);
     }
 
     void FDelegateRegistry::Broadcast(lua_State* L, void* Delegate, int32 NumParams, int32 FirstParamIndex)
@@ -293,15 +335,13 @@ namespace UnLua
         if (!Info)
             return;
 
-        for (const auto& Handler : Info->Handlers)
+        if (Info->Owner.IsValid())
         {
-            if (!Handler.IsValid())
-                continue;
-            if (Info->Owner.IsValid())
-                Handler->RemoveFrom(Info->MulticastProperty, Delegate);
+            for (int32 LinkIndex = Info->FirstLink; LinkIndex != INDEX_NONE; LinkIndex = Links[LinkIndex].NextInDelegate)
+                Links[LinkIndex].Handler->RemoveFrom(Info->MulticastProperty, Delegate);
         }
 
-        Info->Handlers.Empty();
+        UnlinkAll(*Info);
     }
 
 #pragma endregion
@@ -318,10 +358,163 @@ namespace UnLua
 
     ULuaDelegateHandler* FDelegateRegistry::CreateHandler(int LuaRef, UObject* Owner, UObject* SelfObject)
     {
-        const auto Ret = NewObject<ULuaDelegateHandler>();
+        ULuaDelegateHandler* Ret;
+        if (PooledHandlers.Num() > 0)
+        {
+            Ret = PooledHandlers.Pop(false);
+            Stats.PooledHandlers = PooledHandlers.Num();
+            Stats.Reused++;
+        }
+        else
+        {
+            Ret = NewObject<ULuaDelegateHandler>();
+            Env->AutoObjectReference.Add(Ret);
+            Stats.Created++;
+        }
+        Stats.Handlers++;
+
         Ret->Registry = this;
         Ret->LuaRef = LuaRef;
+        Ret->bPoolable = true;
         Ret->SelfObject = SelfObject ? SelfObject : Owner;
         return Ret;
     }
+
+    void FDelegateRegistry::ReleaseHandler(ULuaDelegateHandler* Handler)
+    {
+        // only reuse the handler when no living delegate can call it any more
+        bool bReusable = Handler->bPoolable;
+        while (Handler->FirstLink != INDEX_NONE)
+        {
+            const int32 LinkIndex = Handler->FirstLink;
+            const auto Delegate = Links[LinkIndex].Delegate;
+            const auto& Info = Delegates.FindChecked(Delegate);
+            if (Info.Owner.IsValid())
+            {
+                if (Info.bIsMulticast)
+                {
+                    Handler->RemoveFrom(Info.MulticastProperty, Delegate);
+                    if (Handler->IsAddedTo(Info.MulticastProperty, Delegate))
+                        bReusable = false; // still in the invocation list, e.g. removed while broadcasting
+                }
+                else if (((FScriptDelegate*)Delegate)->GetUObject() == Handler)
+                    ((FScriptDelegate*)Delegate)->Unbind();
+            }
+            else
+            {
+                bReusable = false; // delegate without a living owner may still hold it
+            }
+            Unlink(LinkIndex);
+        }
+
+        const auto L = Env->GetMainState();
+        luaL_unref(L, LUA_REGISTRYINDEX, Handler->LuaRef);
+        Handler->Reset();
+        Stats.Handlers--;
+
+        if (bReusable && PooledHandlers.Num() < MaxPooledHandlers)
+        {
+            PooledHandlers.Add(Handler);
+            Stats.PooledHandlers = PooledHandlers.Num();
+        }
+        else
+        {
+            Env->AutoObjectReference.Remove(Handler);
+        }
+    }
+
+    void FDelegateRegistry::RemoveDelegate(void* Delegate)
+    {
+        const auto Info = Delegates.Find(Delegate);
+        if (!Info)
+            return;
+
+        if (Info->bIsMulticast)
+            Clear(Delegate);
+        else
+            Unbind(Delegate);
+
+        const bool bDeleteOnRemove = Info->bDeleteOnRemove;
+        Delegates.Remove(Delegate);
+        UnownedDelegates.Remove(Delegate);
+        if (bDeleteOnRemove)
+            delete (FScriptDelegate*)Delegate;
+    }
+
+    void FDelegateRegistry::Link(void* Delegate, FDelegateInfo& Info, ULuaDelegateHandler* Handler)
+    {
+        if (FindLink(Delegate, Handler) != INDEX_NONE)
+            return;
+
+        const int32 Index = FreeLinks.Num() > 0 ? FreeLinks.Pop(false) : Links.AddDefaulted();
+        auto& NewLink = Links[Index];
+        NewLink.Delegate = Delegate;
+        NewLink.Handler = Handler;
+        NewLink.PrevInDelegate = INDEX_NONE;
+        NewLink.NextInDelegate = Info.FirstLink;
+        NewLink.PrevInHandler = INDEX_NONE;
+        NewLink.NextInHandler = Handler->FirstLink;
+        if (Info.FirstLink != INDEX_NONE)
+            Links[Info.FirstLink].PrevInDelegate = Index;
+        if (Handler->FirstLink != INDEX_NONE)
+            Links[Handler->FirstLink].PrevInHandler = Index;
+        Info.FirstLink = Index;
+        Handler->FirstLink = Index;
+        Stats.Links++;
+    }
+
+    int32 FDelegateRegistry::FindLink(const void* Delegate, const ULuaDelegateHandler* Handler) const
+    {
+        // a handler is usually bound to very few delegates
+        for (int32 Index = Handler->FirstLink; Index != INDEX_NONE; Index = Links[Index].NextInHandler)
+        {
+            if (Links[Index].Delegate == Delegate)
+                return Index;
+        }
+        return INDEX_NONE;
+    }
+
+    void FDelegateRegistry::Unlink(int32 Index)
+    {
+        auto& ToRemove = Links[Index];
+
+        if (ToRemove.PrevInDelegate != INDEX_NONE)
+            Links[ToRemove.PrevInDelegate].NextInDelegate = ToRemove.NextInDelegate;
+        else if (const auto Info = Delegates.Find(ToRemove.Delegate))
+            Info->FirstLink = ToRemove.NextInDelegate;
+        if (ToRemove.NextInDelegate != INDEX_NONE)
+            Links[ToRemove.NextInDelegate].PrevInDelegate = ToRemove.PrevInDelegate;
+
+        if (ToRemove.PrevInHandler != INDEX_NONE)
+            Links[ToRemove.PrevInHandler].NextInHandler = ToRemove.NextInHandler;
+        else
+            ToRemove.Handler->FirstLink = ToRemove.NextInHandler;
+        if (ToRemove.NextInHandler != INDEX_NONE)
+            Links[ToRemove.NextInHandler].PrevInHandler = ToRemove.PrevInHandler;
+
+        ToRemove = FLink();
+        FreeLinks.Add(Index);
+        Stats.Links--;
+    }
+
+    void FDelegateRegistry::UnlinkAll(FDelegateInfo& Info)
+    {
+        while (Info.FirstLink != INDEX_NONE)
+            Unlink(Info.FirstLink);
+    }
+
+    void FDelegateRegistry::SetOwner(void* Delegate, FDelegateInfo& Info, UObject* Owner)
+    {
+        Info.Owner = Owner;
+        if (Owner)
+        {
+            DelegatesByOwner.AddUnique(Owner, Delegate);
+            UnownedDelegates.Remove(Delegate);
+            Env->GetTouchedObjects()->Mark(Owner);
+        }
+        else
+        {
+            UnownedDelegates.Add(Delegate);
+        }
+    }
 }
@@ -53,12 +53,38 @@ namespace UnLua
     class FDelegateRegistry
     {
     public:
+        struct FStats
+        {
+            int32 Handlers = 0;         // handlers in use
+            int32 PooledHandlers = 0;   // released handlers waiting for reuse
+            int32 Links = 0;            // handler to delegate bindings
+            int32 Created = 0;          // handlers created by NewObject
+            int32 Reused = 0;           // handlers taken from the pool
+            int32 Sweeps = 0;           // post gc sweeps
+            int32 LastSwept = 0;        // delegates and handlers released by the last sweep
+            double LastSweepTime = 0;   // seconds
+            double MaxSweepTime = 0;    // seconds
+        };
+
+        /** Max released handlers kept for reuse, the rest are left to UE GC */
+        static constexpr int32 MaxPooledHandlers = 1024;
+
+        /** Max unowned delegates released by one post gc sweep, the rest wait for the next gc */
+        static constexpr int32 MaxUnownedSweepsPerGC = 256;
+
         explicit FDelegateRegistry(FLuaEnv* Env);
 
         ~FDelegateRegistry();
 
         void OnPostGarbageCollect();
 
+        /** Queue delegates owned by the object and handlers bound to it for the next post gc sweep */
+        void NotifyUObjectDeleted(UObject* Object);
+
+        FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+        void Report() const;
+
         FScriptDelegate* Register(FScriptDelegate* Delegate, FDelegateProperty* Property);
 
         void Register(void* Delegate, FProperty* Property, UObject* Owner);
@@ -90,6 +116,41 @@ namespace UnLua
 
         ULuaDelegateHandler* CreateHandler(int LuaRef, UObject* Owner, UObject* SelfObject);
 
+        /**
+         * Detach the handler from all delegates and put it back to the pool
+         */
+        void ReleaseHandler(ULuaDelegateHandler* Handler);
+
+        /**
+         * Remove the delegate and all its links, delegate memory is only touched when its owner is alive
+         */
+        void RemoveDelegate(void* Delegate);
+
+        /**
+         * One handler bound to one delegate, linked into the lists of both sides
+         */
+        struct FLink
+        {
+            void* Delegate = nullptr;
+            ULuaDelegateHandler* Handler = nullptr;
+            int32 PrevInDelegate = INDEX_NONE;
+            int32 NextInDelegate = INDEX_NONE;
+            int32 PrevInHandler = INDEX_NONE;
+            int32 NextInHandler = INDEX_NONE;
+        };
+
+        struct FDelegateInfo;
+
+        void Link(void* Delegate, FDelegateInfo& Info, ULuaDelegateHandler* Handler);
+
+        int32 FindLink(const void* Delegate, const ULuaDelegateHandler* Handler) const;
+
+        void Unlink(int32 Index);
+
+        void UnlinkAll(FDelegateInfo& Info);
+
+        void SetOwner(void* Delegate, FDelegateInfo& Info, UObject* Owner);
+
         struct FDelegateInfo
         {
             union
@@ -102,13 +163,23 @@ namespace UnLua
             UFunction* SignatureFunction;
             TSharedPtr<FFunctionDesc> Desc;
             TWeakObjectPtr<UObject> Owner;
-            TSet<TWeakObjectPtr<ULuaDelegateHandler>> Handlers;
+            int32 FirstLink = INDEX_NONE;
             bool bIsMulticast;
             bool bDeleteOnRemove;
+            bool bInStruct; // lives in a struct or parameters, which may be copied by value together with the invocation list
         };
 
         TMap<void*, FDelegateInfo> Delegates;
         TMap<FLuaDelegatePair, TWeakObjectPtr<ULuaDelegateHandler>> CachedHandlers;
+        TArray<FLink> Links;
+        TArray<int32> FreeLinks;
+        TArray<ULuaDelegateHandler*> PooledHandlers;
+        TMultiMap<const UObject*, void*> DelegatesByOwner;
+        TMultiMap<const UObject*, FLuaDelegatePair> HandlersBySelf;
+        TSet<void*> UnownedDelegates;
+        TArray<void*> PendingDelegates;
+        TArray<FLuaDelegatePair> PendingHandlers;
+        FStats Stats;
         FLuaEnv* Env;
         FDelegateHandle PostGarbageCollectHandle;
     };
@@ -71,6 +71,7 @@ namespace UnLua
         auto Ret = new FEnumDesc(Enum);
         Enums.Add(Enum, Ret);
         Name2Enums.Add(MetatableName, Ret);
+        Env->GetTouchedObjects()->Mark(Enum);
 
         const auto L = Env->GetMainState();
         const auto MetatableNameUTF8 = FTCHARToUTF8(*MetatableName);
@@ -9,6 +9,16 @@ namespace UnLua
     {
     }
 
+    FFunctionRegistry::~FFunctionRegistry()
+    {
+        // functions are removed from the map once deleted, the rest are still alive
+        for (const auto& Pair : LuaFunctions)
+        {
+            if (Pair.Key->CachedRegistry == this)
+                SetCached(Pair.Key, LUA_NOREF, nullptr);
+        }
+    }
+
     void FFunctionRegistry::NotifyUObjectDeleted(UObject* Object)
     {
         const auto Function = (ULuaFunction*)Object;
@@ -17,6 +27,8 @@ namespace UnLua
             return;
         luaL_unref(Env->GetMainState(), LUA_REGISTRYINDEX, Info->LuaRef);
         LuaFunctions.Remove(Function);
+        if (Function->CachedRegistry == this)
+            SetCached(Function, LUA_NOREF, nullptr);
     }
 
     void FFunctionRegistry::Invoke(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL)
@@ -27,16 +39,25 @@ namespace UnLua
 
         const auto SelfRef = Env->GetObjectRegistry()->GetBoundRef(Context);
         check(SelfRef!=LUA_NOREF);
+        Invoke(Function, Context, SelfRef, Stack, RESULT_PARAM);
+    }
 
+    void FFunctionRegistry::Invoke(ULuaFunction* Function, UObject* Context, int32 SelfRef, FFrame& Stack, RESULT_DECL)
+    {
         const auto L = Env->GetMainState();
         lua_Integer FuncRef;
         FFunctionDesc* FuncDesc;
 
-        const auto Exists = LuaFunctions.Find(Function);
-        if (Exists)
+        if (Function->CachedRegistry == this)
+        {
+            FuncRef = Function->CachedLuaRef;
+            FuncDesc = Function->CachedDesc;
+        }
+        else if (const auto Exists = LuaFunctions.Find(Function))
         {
             FuncRef = Exists->LuaRef;
             FuncDesc = Exists->Desc.Get();
+            SetCached(Function, FuncRef, FuncDesc);
         }
         else
         {
@@ -70,6 +91,8 @@ namespace UnLua
             Info.LuaRef = FuncRef;
             Info.Desc = TUniquePtr<FFunctionDesc>(FuncDesc);
             LuaFunctions.Add(Function, MoveTemp(Info));
+            Env->GetTouchedObjects()->Mark(Function);
+            SetCached(Function, FuncRef, FuncDesc);
         }
 
         if (FuncRef == LUA_NOREF)
@@ -80,6 +103,13 @@ namespace UnLua
                 Overridden->Invoke(Context, Stack, RESULT_PARAM);
             return;
         }
-        FuncDesc->CallLua(L, FuncRef, SelfRef, Stack, RESULT_PARAM);
+        FuncDesc->CallLua(*Env, FuncRef, SelfRef, Stack, RESULT_PARAM);
+    }
+
+    void FFunctionRegistry::SetCached(ULuaFunction* Function, int32 LuaRef, FFunctionDesc* Desc)
+    {
+        Function->CachedRegistry = Desc ? this : nullptr;
+        Function->CachedLuaRef = LuaRef;
+        Function->CachedDesc = Desc;
     }
 }
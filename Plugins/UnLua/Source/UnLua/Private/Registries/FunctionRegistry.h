@@ -27,11 +27,20 @@ namespace UnLua
     public:
         explicit FFunctionRegistry(FLuaEnv* Env);
 
+        ~FFunctionRegistry();
+
         void NotifyUObjectDeleted(UObject* Object);
         
         void Invoke(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL);
 
+        /**
+         * Invoke with the lua instance of an already bound object, skipping binding lookups
+         */
+        void Invoke(ULuaFunction* Function, UObject* Context, int32 SelfRef, FFrame& Stack, RESULT_DECL);
+
     private:
+        void SetCached(ULuaFunction* Function, int32 LuaRef, FFunctionDesc* Desc);
+
         struct FFunctionInfo
         {
             lua_Integer LuaRef;
@@ -16,12 +16,14 @@
 #include "LowLevel.h"
 #include "LuaEnv.h"
 #include "UnLuaDelegates.h"
+#include "UnLuaSettings.h"
 
 namespace UnLua
 {
-    static const char* REGISTRY_KEY = "UnLua_ObjectMap";
     static const char* MANUAL_REF_PROXY_MAP = "UnLua_ManualRefProxyMap";
 
+    TArray<FObjectRegistry::FBinding> FObjectRegistry::Bindings;
+
     static int ReleaseSharedPtr(lua_State* L)
     {
         const auto Ptr = (TSharedPtr<void>*)lua_touserdata(L, 1);
@@ -47,11 +49,9 @@ namespace UnLua
     FObjectRegistry::FObjectRegistry(FLuaEnv* Env)
         : Env(Env)
     {
-        const auto L = Env->GetMainState();
+        bDenseTable = GetDefault<UUnLuaSettings>()->bEnableDenseObjectTable;
 
-        lua_pushstring(L, REGISTRY_KEY);
-        LowLevel::CreateWeakValueTable(L);
-        lua_rawset(L, LUA_REGISTRYINDEX);
+        const auto L = Env->GetMainState();
 
         lua_pushstring(L, MANUAL_REF_PROXY_MAP);
         LowLevel::CreateWeakValueTable(L);
@@ -70,6 +70,29 @@ namespace UnLua
         lua_pop(L, 2);
     }
 
+    FObjectRegistry::~FObjectRegistry()
+    {
+        // objects may be gone already, don't touch them
+        for (int32 Index = 0; Index < Bindings.Num(); Index++)
+        {
+            auto& Binding = Bindings[Index];
+            if (!Binding.Object)
+                continue;
+
+            bool bBoundHere = Binding.Env == Env;
+            if (!bBoundHere && !Binding.Env)
+            {
+                // shared with other envs, find out from our own refs
+                const int32* Ref = bDenseTable
+                                       ? (Slots.IsValidIndex(Index) && Slots[Index].Object == Binding.Object ? &Slots[Index].Ref : nullptr)
+                                       : ObjectRefs.Find((UObject*)Binding.Object);
+                bBoundHere = Ref && *Ref != LUA_NOREF;
+            }
+            if (bBoundHere && --Binding.NumEnvs <= 0)
+                Binding = FBinding();
+        }
+    }
+
     void FObjectRegistry::NotifyUObjectDeleted(UObject* Object)
     {
         Unbind(Object);
@@ -95,7 +118,18 @@ namespace UnLua
             return;
         }
 
-        lua_getfield(L, LUA_REGISTRYINDEX, REGISTRY_KEY);
+        if (bDenseTable)
+        {
+            // bound instances are pushed by their refs directly
+            const auto Ref = FindRef(Object);
+            if (Ref && *Ref >= 0)
+            {
+                lua_rawgeti(L, LUA_REGISTRYINDEX, *Ref);
+                return;
+            }
+        }
+
+        Env->PushRegistryTable(L, ERegistryTable::ObjectMap);
         lua_pushlightuserdata(L, Object);
         const auto Type = lua_rawget(L, -2);
         if (Type == LUA_TNIL)
@@ -105,14 +139,15 @@ namespace UnLua
             lua_pushlightuserdata(L, Object);
             lua_pushvalue(L, -2);
             lua_rawset(L, -4);
-            ObjectRefs.Add(Object, LUA_NOREF);
+            AddRef(Object, LUA_NOREF);
+            Env->GetTouchedObjects()->Mark(Object);
         }
         lua_remove(L, -2);
     }
 
     int FObjectRegistry::Bind(UObject* Object)
     {
-        if (const auto Exists = ObjectRefs.Find(Object))
+        if (const auto Exists = FindRef(Object))
         {
             if (*Exists != LUA_NOREF)
                 return *Exists;
@@ -122,7 +157,7 @@ namespace UnLua
 
         int OldTop = lua_gettop(L);
 
-        lua_getfield(L, LUA_REGISTRYINDEX, REGISTRY_KEY);
+        Env->PushRegistryTable(L, ERegistryTable::ObjectMap);
         lua_pushlightuserdata(L, Object);
         lua_newtable(L); // create a Lua table ('INSTANCE')
         PushObjectCore(L, Object); // push UObject ('RAW_UOBJECT')
@@ -153,7 +188,9 @@ namespace UnLua
 
         lua_pushvalue(L, -1);
         const auto Ret = luaL_ref(L, LUA_REGISTRYINDEX);
-        ObjectRefs.Add(Object, Ret);
+        AddRef(Object, Ret);
+        Env->GetTouchedObjects()->Mark(Object);
+        SetBinding(Object, Ret);
 
         FUnLuaDelegates::OnObjectBinded.Broadcast(Object); // 'INSTANCE' is on the top of stack now
 
@@ -164,13 +201,13 @@ namespace UnLua
 
     bool FObjectRegistry::IsBound(const UObject* Object) const
     {
-        const auto Exists = ObjectRefs.Find(Object);
+        const auto Exists = FindRef(Object);
         return Exists && *Exists != LUA_NOREF;
     }
 
     int FObjectRegistry::GetBoundRef(const UObject* Object) const
     {
-        const auto Ref = ObjectRefs.Find(Object);
+        const auto Ref = FindRef(Object);
         if (Ref)
             return *Ref;
         return LUA_NOREF;
@@ -179,9 +216,12 @@ namespace UnLua
     void FObjectRegistry::Unbind(UObject* Object)
     {
         int32 Ref;
-        if (!ObjectRefs.RemoveAndCopyValue(Object, Ref))
+        if (!RemoveRef(Object, Ref))
             return;
 
+        if (Ref != LUA_NOREF)
+            ClearBinding(Object);
+
         const auto L = Env->GetMainState();
         const auto Top = lua_gettop(L);
         RemoveFromObjectMapAndPushToStack(Object);
@@ -245,10 +285,76 @@ namespace UnLua
         Env->RemoveManualObjectReference(Object);
     }
 
+    void FObjectRegistry::AddRef(UObject* Object, int32 Ref)
+    {
+        if (!bDenseTable)
+        {
+            ObjectRefs.Add(Object, Ref);
+            return;
+        }
+
+        const int32 Index = GUObjectArray.ObjectToIndex(Object);
+        if (Index >= Slots.Num())
+            Slots.SetNum(FMath::Max(Index + 1, GUObjectArray.GetObjectArrayNum()));
+        auto& Slot = Slots[Index];
+        Slot.Object = Object;
+        Slot.SerialNumber = GUObjectArray.AllocateSerialNumber(Index);
+        Slot.Ref = Ref;
+    }
+
+    bool FObjectRegistry::RemoveRef(UObject* Object, int32& OutRef)
+    {
+        if (!bDenseTable)
+            return ObjectRefs.RemoveAndCopyValue(Object, OutRef);
+
+        // FindRef checks both the object and its serial number, a reused index never removes another object's slot
+        const auto Exists = FindRef(Object);
+        if (!Exists)
+            return false;
+        OutRef = *Exists;
+        Slots[GUObjectArray.ObjectToIndex(Object)] = FObjectSlot();
+        return true;
+    }
+
+    void FObjectRegistry::SetBinding(const UObject* Object, int32 Ref)
+    {
+        const int32 Index = GUObjectArray.ObjectToIndex(Object);
+        if (Index < 0)
+            return;
+        if (Index >= Bindings.Num())
+            Bindings.SetNum(FMath::Max(Index + 1, GUObjectArray.GetObjectArrayNum()));
+        auto& Binding = Bindings[Index];
+        if (Binding.Object == Object && Binding.NumEnvs > 0)
+        {
+            // bound by another env too, which env to call has to be located
+            Binding.Env = nullptr;
+            Binding.Ref = LUA_NOREF;
+            Binding.NumEnvs++;
+            return;
+        }
+        Binding.Object = Object;
+        Binding.Env = Env;
+        Binding.Ref = Ref;
+        Binding.NumEnvs = 1;
+    }
+
+    void FObjectRegistry::ClearBinding(const UObject* Object)
+    {
+        const int32 Index = GUObjectArray.ObjectToIndex(Object);
+        if (!Bindings.IsValidIndex(Index))
+            return;
+        auto& Binding = Bindings[Index];
+        if (Binding.Object != Object)
+            return;
+        // the rest env is unknown after sharing, keep locating it
+        if (--Binding.NumEnvs <= 0)
+            Binding = FBinding();
+    }
+
     void FObjectRegistry::RemoveFromObjectMapAndPushToStack(UObject* Object)
     {
         const auto L = Env->GetMainState();
-        lua_getfield(L, LUA_REGISTRYINDEX, REGISTRY_KEY);
+        Env->PushRegistryTable(L, ERegistryTable::ObjectMap);
         lua_pushlightuserdata(L, Object);
         lua_rawget(L, -2);
         lua_pushlightuserdata(L, Object);
@@ -30,8 +30,35 @@ namespace UnLua
     class FObjectRegistry
     {
     public:
+        /**
+         * 已绑定对象所在的Lua环境和table引用，按GUObjectArray索引存放，只在游戏线程访问。
+         * 同一个对象被多个Lua环境绑定时不记录环境，调用时仍需定位Lua环境。
+         */
+        struct FBinding
+        {
+            const UObject* Object = nullptr;
+            FLuaEnv* Env = nullptr;
+            int32 Ref = LUA_NOREF;
+            int32 NumEnvs = 0;
+        };
+
         explicit FObjectRegistry(FLuaEnv* Env);
 
+        ~FObjectRegistry();
+
+        /**
+         * 查找UObject的绑定信息，不需要定位Lua环境。
+         * @return 若没有绑定过或被多个Lua环境绑定则返回nullptr。
+         */
+        static FORCEINLINE const FBinding* FindBinding(const UObject* Object)
+        {
+            const int32 Index = GUObjectArray.ObjectToIndex(Object);
+            if (!Bindings.IsValidIndex(Index))
+                return nullptr;
+            const auto& Binding = Bindings[Index];
+            return Binding.Object == Object && Binding.Env ? &Binding : nullptr;
+        }
+
         void NotifyUObjectDeleted(UObject* Object);
 
         void NotifyUObjectLuaGC(UObject* Object);
@@ -77,10 +104,49 @@ namespace UnLua
         void RemoveManualRef(UObject* Object);
 
     private:
+        /**
+         * 按GUObjectArray索引存放的引用，对象指针和序列号都与当前一致时才有效
+         */
+        struct FObjectSlot
+        {
+            const UObject* Object = nullptr;
+            int32 SerialNumber = 0;
+            int32 Ref = LUA_NOREF;
+        };
+
+        /**
+         * 密集表模式下会通过对象取索引，调用前需确保Object是有效的UObject
+         */
+        FORCEINLINE const int32* FindRef(const UObject* Object) const
+        {
+            if (!bDenseTable)
+                return ObjectRefs.Find(Object);
+
+            const int32 Index = GUObjectArray.ObjectToIndex(Object);
+            if (!Slots.IsValidIndex(Index))
+                return nullptr;
+            const auto& Slot = Slots[Index];
+            if (Slot.Object != Object || Slot.SerialNumber != GUObjectArray.GetSerialNumber(Index))
+                return nullptr;
+            return &Slot.Ref;
+        }
+
+        void AddRef(UObject* Object, int32 Ref);
+
+        bool RemoveRef(UObject* Object, int32& OutRef);
+
         void RemoveFromObjectMapAndPushToStack(UObject* Object);
 
+        void SetBinding(const UObject* Object, int32 Ref);
+
+        void ClearBinding(const UObject* Object);
+
+        static TArray<FBinding> Bindings;
+
         FLuaEnv* Env;
         TMap<UObject*, int32> ObjectRefs;
+        TArray<FObjectSlot> Slots; // used instead of ObjectRefs with dense table enabled
+        bool bDenseTable;
     };
 
     template <typename T>
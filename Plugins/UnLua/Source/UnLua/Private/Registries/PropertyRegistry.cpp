@@ -471,6 +471,7 @@ namespace UnLua
 
         const auto Ret = TSharedPtr<ITypeInterface>(FPropertyDesc::Create(Property));
         FieldProperties.Add(Field, Ret);
+        Env->GetTouchedObjects()->Mark(Field);
         return Ret;
     }
 }
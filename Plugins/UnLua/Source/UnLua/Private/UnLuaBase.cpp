@@ -134,7 +134,7 @@ namespace UnLua
         }
 
         const auto& Env = FLuaEnv::FindEnvChecked(L);
-        const auto DanglingGuard = Env.GetDanglingCheck()->MakeGuard();
+        const FDanglingCheck::FGuard DanglingGuard(Env.GetDanglingCheck());
         bool bSuccess = !luaL_dostring(L, Chunk);       // loads and runs the given chunk
         if (!bSuccess)
         {
@@ -196,7 +196,7 @@ namespace UnLua
         if (!bAlwaysCreate)
         {
             // find the pointer from 'StructMap' first
-            lua_getfield(L, LUA_REGISTRYINDEX, "StructMap");
+            FLuaEnv::FindEnvChecked(L).PushRegistryTable(L, ERegistryTable::StructMap);
             lua_pushlightuserdata(L, Value);
             int32 Type = lua_rawget(L, -2);
             if (Type == LUA_TUSERDATA)
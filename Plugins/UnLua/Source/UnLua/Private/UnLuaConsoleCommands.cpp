@@ -20,6 +20,31 @@ namespace UnLua
               *LOCTEXT("CommandText_CollectGarbage", "Force collect garbage in lua env.").ToString(),
               FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::CollectGarbage)
           ),
+          BindStatsCommand(
+              TEXT("lua.bindstats"),
+              *LOCTEXT("CommandText_BindStats", "Dump cached binding decisions of classes in lua env.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::BindStats)
+          ),
+          GCStatsCommand(
+              TEXT("lua.gcstats"),
+              *LOCTEXT("CommandText_GCStats", "Dump GC scheduler and deleted object stats of lua env.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::GCStats)
+          ),
+          NameCacheStatsCommand(
+              TEXT("lua.namecachestats"),
+              *LOCTEXT("CommandText_NameCacheStats", "Dump FName/FString cache stats of lua env.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::NameCacheStats)
+          ),
+          ParamArenaCommand(
+              TEXT("lua.paramarena"),
+              *LOCTEXT("CommandText_ParamArena", "Dump param buffer arena stats of lua env. Usage: lua.paramarena [0/1] to disable/enable the arena.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::ParamArena)
+          ),
+          DelegateStatsCommand(
+              TEXT("lua.delegatestats"),
+              *LOCTEXT("CommandText_DelegateStats", "Dump delegate handler count and post gc sweep time of lua env.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::DelegateStats)
+          ),
           Module(InModule)
     {
     }
@@ -79,6 +104,84 @@ namespace UnLua
 
         Env->GC();
     }
+
+    void FUnLuaConsoleCommands::BindStats(const TArray<FString>& Args) const
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to dump bind stats."));
+            return;
+        }
+
+        static const TCHAR* KindNames[] = {TEXT("Never"), TEXT("Static"), TEXT("Dynamic")};
+
+        auto Decisions = Env->GetBindDecisions();
+        Decisions.ValueSort([](const FLuaEnv::FBindDecision& A, const FLuaEnv::FBindDecision& B)
+        {
+            return A.Hits + A.Rejects > B.Hits + B.Rejects;
+        });
+
+        UE_LOG(LogUnLua, Log, TEXT("%d classes cached in %s:"), Decisions.Num(), *Env->GetName());
+        for (const auto& Pair : Decisions)
+        {
+            const auto& Decision = Pair.Value;
+            UE_LOG(LogUnLua, Log, TEXT("  %-48s %-8s hits=%-8d rejects=%-8d %s"), *Pair.Key->GetName(), KindNames[(int32)Decision.Kind],
+                   Decision.Hits, Decision.Rejects, *Decision.ModuleName);
+        }
+    }
+
+    void FUnLuaConsoleCommands::GCStats(const TArray<FString>& Args) const
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to dump gc stats."));
+            return;
+        }
+
+        Env->GetGCScheduler()->Report();
+        Env->GetTouchedObjects()->Report();
+    }
+
+    void FUnLuaConsoleCommands::NameCacheStats(const TArray<FString>& Args) const
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to dump name cache stats."));
+            return;
+        }
+
+        Env->GetNameCache()->Report();
+    }
+
+    void FUnLuaConsoleCommands::ParamArena(const TArray<FString>& Args) const
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to dump param buffer arena stats."));
+            return;
+        }
+
+        const auto Arena = Env->GetParamBufferArena();
+        if (Args.Num() > 0)
+            Arena->SetEnabled(Args[0].ToBool());
+        Arena->Report();
+    }
+
+    void FUnLuaConsoleCommands::DelegateStats(const TArray<FString>& Args) const
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to dump delegate stats."));
+            return;
+        }
+
+        Env->GetDelegateRegistry()->Report();
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -27,6 +27,16 @@ namespace UnLua
 
         FAutoConsoleCommand CollectGarbageCommand;
 
+        FAutoConsoleCommand BindStatsCommand;
+
+        FAutoConsoleCommand GCStatsCommand;
+
+        FAutoConsoleCommand NameCacheStatsCommand;
+
+        FAutoConsoleCommand ParamArenaCommand;
+
+        FAutoConsoleCommand DelegateStatsCommand;
+
         explicit FUnLuaConsoleCommands(IUnLuaModule* InModule);
 
         void Do(const TArray<FString>& Args) const;
@@ -35,6 +45,16 @@ namespace UnLua
 
         void CollectGarbage(const TArray<FString>& Args) const;
 
+        void BindStats(const TArray<FString>& Args) const;
+
+        void GCStats(const TArray<FString>& Args) const;
+
+        void NameCacheStats(const TArray<FString>& Args) const;
+
+        void ParamArena(const TArray<FString>& Args) const;
+
+        void DelegateStats(const TArray<FString>& Args) const;
+
     private:
         IUnLuaModule* Module;
     };
@@ -63,6 +63,51 @@ bool UUnLuaManager::Bind(UObject *Object, const TCHAR *InModuleName, int32 Initi
     if (!Env->GetClassRegistry()->Register(Class))
         return false;
 
+    // no need to require again if the class was already bound to this module
+    const auto BindInfo = Classes.Find(Class);
+    if (!BindInfo || !IsClassBound(*BindInfo) || BindInfo->ModuleName != InModuleName)
+    {
+        if (!Require(Object, Class, InModuleName))
+            return false;
+    }
+
+    // create a Lua instance for this UObject
+    Env->GetObjectRegistry()->Bind(Class);
+    const auto ObjectRef = Env->GetObjectRegistry()->Bind(Object);
+    if (ObjectRef == LUA_REFNIL)
+        return true;
+
+    // binding may run lua code and add new classes, so find it again
+    const auto BoundInfo = Classes.Find(Class);
+    if (!BoundInfo)
+        return true;
+
+    // try call user first user function handler
+    const auto FunctionRef = ResolveInitializeRef(*BoundInfo);
+    if (FunctionRef != LUA_REFNIL && PushFunction(L, Object, FunctionRef))   // push hard coded Lua function 'Initialize'
+    {
+        if (InitializerTableRef != LUA_NOREF)
+        {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, InitializerTableRef);             // push a initializer table if necessary
+        }
+        else
+        {
+            lua_pushnil(L);
+        }
+        bool bResult = ::CallFunction(L, 2, 0);                                 // call 'Initialize'
+        if (!bResult)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("Failed to call 'Initialize' function!"));
+        }
+    }
+
+    return true;
+}
+
+bool UUnLuaManager::Require(UObject* Object, UClass* Class, const TCHAR* InModuleName)
+{
+    lua_State *L = Env->GetMainState();
+
     // try bind lua if not bind or use a copyed table
     UnLua::FLuaRetValues RetValues = UnLua::Call(L, "require", TCHAR_TO_UTF8(InModuleName));
     FString Error;
@@ -89,30 +134,6 @@ bool UUnLuaManager::Bind(UObject *Object, const TCHAR *InModuleName, int32 Initi
         return false;
     }
 
-    // create a Lua instance for this UObject
-    Env->GetObjectRegistry()->Bind(Class);
-    Env->GetObjectRegistry()->Bind(Object);
-
-    // try call user first user function handler
-    int32 FunctionRef = PushFunction(L, Object, "Initialize");                  // push hard coded Lua function 'Initialize'
-    if (FunctionRef != LUA_NOREF)
-    {
-        if (InitializerTableRef != LUA_NOREF)
-        {
-            lua_rawgeti(L, LUA_REGISTRYINDEX, InitializerTableRef);             // push a initializer table if necessary
-        }
-        else
-        {
-            lua_pushnil(L);
-        }
-        bool bResult = ::CallFunction(L, 2, 0);                                 // call 'Initialize'
-        if (!bResult)
-        {
-            UE_LOG(LogUnLua, Warning, TEXT("Failed to call 'Initialize' function!"));
-        }
-        luaL_unref(L, LUA_REGISTRYINDEX, FunctionRef);
-    }
-
     return true;
 }
 
@@ -125,6 +146,7 @@ void UUnLuaManager::NotifyUObjectDeleted(const UObjectBase* Object)
 
     const auto L = Env->GetMainState();
     luaL_unref(L, LUA_REGISTRYINDEX, BindInfo->TableRef);
+    luaL_unref(L, LUA_REGISTRYINDEX, BindInfo->InitializeRef);
     Classes.Remove(Class);
 }
 
@@ -145,6 +167,19 @@ int UUnLuaManager::GetBoundRef(const UClass* Class)
     return Info->TableRef;
 }
 
+/**
+ * Drop cached 'Initialize' functions, they will be resolved again on next binding
+ */
+void UUnLuaManager::ResetInitializeRefs()
+{
+    const auto L = Env->GetMainState();
+    for (auto& Pair : Classes)
+    {
+        luaL_unref(L, LUA_REGISTRYINDEX, Pair.Value.InitializeRef);
+        Pair.Value.InitializeRef = LUA_NOREF;
+    }
+}
+
 /**
  * Get all default Axis/Action inputs
  */
@@ -257,20 +292,17 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
     if (Class->HasAnyFlags(RF_NeedPostLoad | RF_NeedPostLoadSubobjects))
         return false;
 
-    if (Classes.Contains(Class))
+    const auto  L = Env->GetMainState();
+    if (const auto Exists = Classes.Find(Class))
     {
-#if WITH_EDITOR
-        // 兼容蓝图Recompile导致FuncMap被清空的情况
-        if (Class->FindFunctionByName("__UClassBindSucceeded", EIncludeSuperFlag::Type::ExcludeSuper))
+        if (IsClassBound(*Exists))
             return true;
-        
+
         ULuaFunction::RestoreOverrides(Class);
-#else
-        return true;
-#endif
+        luaL_unref(L, LUA_REGISTRYINDEX, Exists->TableRef);
+        luaL_unref(L, LUA_REGISTRYINDEX, Exists->InitializeRef);
     }
 
-    const auto  L = Env->GetMainState();
     const auto Top = lua_gettop(L);
     const auto Type = UnLua::LowLevel::GetLoadedModule(L, TCHAR_TO_UTF8(*InModuleName));
     if (Type != LUA_TTABLE)
@@ -298,6 +330,7 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
     lua_settop(L, Top);
 
     auto& BindInfo = Classes.Add(Class);
+    Env->GetTouchedObjects()->Mark(Class);
     BindInfo.Class = Class;
     BindInfo.ModuleName = InModuleName;
     BindInfo.TableRef = Ref;
@@ -361,6 +394,45 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
     return true;
 }
 
+bool UUnLuaManager::IsClassBound(const FClassBindInfo& BindInfo) const
+{
+#if WITH_EDITOR
+    // 兼容蓝图Recompile导致FuncMap被清空的情况
+    return BindInfo.Class->FindFunctionByName("__UClassBindSucceeded", EIncludeSuperFlag::Type::ExcludeSuper) != nullptr;
+#else
+    return true;
+#endif
+}
+
+/**
+ * Resolve 'Initialize' from the bound module and its super modules, cache it in registry
+ */
+int UUnLuaManager::ResolveInitializeRef(FClassBindInfo& BindInfo)
+{
+    if (BindInfo.InitializeRef != LUA_NOREF)
+        return BindInfo.InitializeRef;
+
+    const auto L = Env->GetMainState();
+    const auto Top = lua_gettop(L);
+    BindInfo.InitializeRef = LUA_REFNIL;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, BindInfo.TableRef);
+    while (lua_istable(L, -1))
+    {
+        lua_pushstring(L, "Initialize");
+        if (lua_rawget(L, -2) == LUA_TFUNCTION)
+        {
+            BindInfo.InitializeRef = luaL_ref(L, LUA_REGISTRYINDEX);
+            break;
+        }
+        lua_pop(L, 1);
+        lua_pushstring(L, "Super");
+        lua_rawget(L, -2);
+        lua_remove(L, -2);
+    }
+    lua_settop(L, Top);
+    return BindInfo.InitializeRef;
+}
+
 /**
  * Replace action inputs
  */
@@ -29,6 +29,7 @@
 #include "GameDelegates.h"
 #include "LuaEnvLocator.h"
 #include "LuaOverrides.h"
+#include "LuaPreBind.h"
 #include "UnLuaDebugBase.h"
 #include "UnLuaInterface.h"
 #include "UnLuaSettings.h"
@@ -106,26 +107,12 @@ namespace UnLua
                 EnvLocator->AddToRoot();
                 FDeadLoopCheck::Timeout = Settings.DeadLoopCheck;
                 FDanglingCheck::Enabled = Settings.DanglingCheck;
+                FLuaFileSystemCache::BytecodeCacheEnabled = Settings.bEnableBytecodeCache;
 
-                for (const auto Class : TObjectRange<UClass>())
-                {
-                    for (const auto& ClassPath : Settings.PreBindClasses)
-                    {
-                        if (!ClassPath.IsValid())
-                            continue;
-
-                        const auto TargetClass = ClassPath.ResolveClass();
-                        if (!TargetClass)
-                            continue;
-
-                        if (Class->IsChildOf(TargetClass))
-                        {
-                            const auto Env = EnvLocator->Locate(Class);
-                            Env->TryBind(Class);
-                            break;
-                        }
-                    }
-                }
+                const auto Timings = FPreBindManifest::PreBind(EnvLocator, Settings.PreBindClasses);
+                UE_LOG(LogUnLua, Log, TEXT("PreBind %d classes from %s, %d modules prefetched. resolve %.2fms, prefetch %.2fms, bind %.2fms."),
+                       Timings.Classes, Timings.bFromManifest ? TEXT("manifest") : TEXT("loaded classes"), Timings.Modules,
+                       Timings.Resolve * 1000, Timings.Prefetch * 1000, Timings.Bind * 1000);
             }
             else
             {
@@ -46,6 +46,8 @@ public:
 
     void RemoveFrom(FMulticastDelegateProperty* InProperty, void* InDelegate);
 
+    bool IsAddedTo(FMulticastDelegateProperty* InProperty, void* InDelegate) const;
+
     virtual void BeginDestroy() override;
 
     void Reset();
@@ -55,4 +57,6 @@ private:
     UnLua::FDelegateRegistry* Registry;
     int32 LuaRef;
     void* Delegate;
+    int32 FirstLink; // head of the link list in registry
+    bool bPoolable; // false once bound to a delegate which may be copied by value, the copies live out of sight
 };
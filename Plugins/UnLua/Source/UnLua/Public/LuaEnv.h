@@ -28,10 +28,34 @@
 #include "HAL/Platform.h"
 #include "LuaDanglingCheck.h"
 #include "LuaDeadLoopCheck.h"
+#include "LuaFileSystemCache.h"
+#include "LuaGCScheduler.h"
+#include "LuaNameCache.h"
+#include "LuaParamBufferArena.h"
+#include "LuaPoolAllocator.h"
+#include "LuaTouchedObjects.h"
 #include "LuaModuleLocator.h"
 
 namespace UnLua
 {
+    /**
+     * Weak tables pinned in lua registry by FLuaEnv
+     */
+    enum class ERegistryTable : uint8
+    {
+        ObjectMap,
+        StructMap,
+        ArrayMap,
+        ScriptContainerMap,
+        Num
+    };
+
+    enum class ELuaAllocator : uint8
+    {
+        Default,    // everything from FMemory
+        Pooled,     // small blocks from size-class pools, see FLuaPoolAllocator
+    };
+
     class UNLUA_API FLuaEnv
         : public FUObjectArray::FUObjectDeleteListener
     {
@@ -46,19 +70,63 @@ namespace UnLua
 
         DECLARE_DELEGATE_RetVal_FourParams(bool, FLuaFileLoader, const FLuaEnv& /* Env */, const FString& /* FilePath */, TArray<uint8>&/* Data */, FString&/* RealFilePath */);
 
+        /**
+         * Cached binding decision of a class
+         */
+        struct FBindDecision
+        {
+            enum class EKind : uint8
+            {
+                Never,      // never bind
+                Static,     // always bind with ModuleName
+                Dynamic,    // bind only when dynamic binding is active
+            };
+
+            EKind Kind = EKind::Never;
+            FString ModuleName;
+            int32 Hits = 0;
+            int32 Rejects = 0;
+        };
+
+        /**
+         * Counters of objects created in loading threads and bound later in game thread
+         */
+        struct FCandidateStats
+        {
+            int32 Queued = 0;       // added by loading threads
+            int32 Processed = 0;    // handed to TryBind
+            int32 Discarded = 0;    // gone before processed
+            int32 Deferred = 0;     // still loading, retried on next update
+            int32 MaxBatch = 0;     // max candidates processed in one update
+        };
+
         static FOnCreated OnCreated;
 
         static FOnDestroyed OnDestroyed;
 
         FLuaEnv();
 
+        explicit FLuaEnv(ELuaAllocator Allocator);
+
         virtual ~FLuaEnv() override;
 
         static TMap<lua_State*, FLuaEnv*>& GetAll();
 
-        static FLuaEnv* FindEnv(const lua_State* L);
+        /**
+         * Env pointer is kept in the extra space of main thread, which is copied to every coroutine on creation.
+         * lua_newstate zeroes the extra space, so states not created by an env give nullptr.
+         */
+        FORCEINLINE static FLuaEnv* FindEnv(const lua_State* L)
+        {
+            return L ? *static_cast<FLuaEnv**>(lua_getextraspace(const_cast<lua_State*>(L))) : nullptr;
+        }
 
-        static FLuaEnv& FindEnvChecked(const lua_State* L);
+        FORCEINLINE static FLuaEnv& FindEnvChecked(const lua_State* L)
+        {
+            const auto Env = FindEnv(L);
+            check(Env);
+            return *Env;
+        }
 
         void Start(const TMap<FString, UObject*>& Args = {});
 
@@ -76,6 +144,15 @@ namespace UnLua
 
         virtual bool TryReplaceInputs(UObject* Object);
 
+        /** Queue an object to bind on next async loading flush update, safe to call from any thread */
+        void AddCandidate(UObject* Object);
+
+        FORCEINLINE const FCandidateStats& GetCandidateStats() const { return CandidateStats; }
+
+        FORCEINLINE const TMap<UClass*, FBindDecision>& GetBindDecisions() const { return BindDecisions; }
+
+        void ResetBindDecisions();
+
         bool DoString(const FString& Chunk, const FString& ChunkName = "chunk");
 
         virtual void GC();
@@ -112,6 +189,21 @@ namespace UnLua
 
         FORCEINLINE FDeadLoopCheck* GetDeadLoopCheck() const { return DeadLoopCheck; }
 
+        FORCEINLINE FLuaFileSystemCache* GetFileSystemCache() const { return FileSystemCache; }
+
+        FORCEINLINE FLuaGCScheduler* GetGCScheduler() const { return GCScheduler; }
+
+        FORCEINLINE FLuaNameCache* GetNameCache() const { return NameCache; }
+
+        FORCEINLINE FParamBufferArena* GetParamBufferArena() const { return ParamBufferArena; }
+
+        FORCEINLINE FLuaTouchedObjects* GetTouchedObjects() const { return TouchedObjects; }
+
+        /** Returns nullptr if the env doesn't use pooled allocator */
+        FORCEINLINE FLuaPoolAllocator* GetPoolAllocator() const { return PoolAllocator; }
+
+        FORCEINLINE int PushRegistryTable(lua_State* InL, const ERegistryTable Table) const { return lua_rawgeti(InL, LUA_REGISTRYINDEX, RegistryTableRefs[(int32)Table]); }
+
         void AddLoader(const FLuaFileLoader Loader);
 
         void AddBuiltInLoader(const FString InName, lua_CFunction Loader);
@@ -148,6 +240,10 @@ namespace UnLua
     private:
         void AddSearcher(lua_CFunction Searcher, int Index) const;
 
+        void CreateRegistryTables();
+
+        bool ResolveBindDecision(UObject* Object, UClass* Class, FBindDecision& OutDecision) const;
+
         bool LoadBuffer(lua_State* InL, const char* Buffer, const size_t Size, const char* InName);
 
         void OnAsyncLoadingFlushUpdate();
@@ -161,7 +257,11 @@ namespace UnLua
         static TMap<lua_State*, FLuaEnv*> AllEnvs;
         TMap<FString, lua_CFunction> BuiltinLoaders;
         TArray<FLuaFileLoader> CustomLoaders;
-        TArray<FWeakObjectPtr> Candidates; // binding candidates during async loading
+        TArray<FWeakObjectPtr> Candidates; // binding candidates during async loading, guarded by CandidatesLock
+        TArray<FWeakObjectPtr> IncomingCandidates; // swapped with Candidates in game thread
+        TArray<FWeakObjectPtr> DeferredCandidates; // candidates still loading, only accessed in game thread
+        FCandidateStats CandidateStats;
+        TMap<UClass*, FBindDecision> BindDecisions; // only accessed in game thread
         ULuaModuleLocator* ModuleLocator;
         FCriticalSection CandidatesLock;
         FObjectReferencer AutoObjectReference;
@@ -176,11 +276,21 @@ namespace UnLua
         FEnumRegistry* EnumRegistry;
         FDanglingCheck* DanglingCheck;
         FDeadLoopCheck* DeadLoopCheck;
+        FLuaFileSystemCache* FileSystemCache;
+        FLuaGCScheduler* GCScheduler;
+        FLuaNameCache* NameCache;
+        FParamBufferArena* ParamBufferArena;
+        FLuaTouchedObjects* TouchedObjects;
+        FLuaPoolAllocator* PoolAllocator = nullptr;
+        int32 RegistryTableRefs[(int32)ERegistryTable::Num];
         TMap<lua_State*, int32> ThreadToRef;
         TMap<int32, lua_State*> RefToThread;
         FDelegateHandle OnAsyncLoadingFlushUpdateHandle;
         TArray<UInputComponent*> CandidateInputComponents;
         FDelegateHandle OnWorldTickStartHandle;
+#if WITH_EDITOR
+        FDelegateHandle OnObjectsReplacedHandle;
+#endif
         FString Name = TEXT("Env_0");
         bool bObjectArrayListenerRegistered;
         bool bStarted;
@@ -47,4 +47,18 @@ public:
     UnLua::FLuaEnv* GetDefault();
 
     TMap<TWeakObjectPtr<UGameInstance>, TSharedPtr<UnLua::FLuaEnv, ESPMode::ThreadSafe>> Envs;
+
+private:
+    UnLua::FLuaEnv* FindOrAdd(UGameInstance* GameInstance);
+
+    void InvalidateWorlds();
+
+    void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    // only written in game thread, other threads read WorldEnvs with the lock held
+    TMap<TWeakObjectPtr<UWorld>, UnLua::FLuaEnv*> WorldEnvs; // worlds with game instance located
+    FCriticalSection WorldEnvsLock;
+    TWeakObjectPtr<UWorld> LastWorld; // game thread only
+    UnLua::FLuaEnv* LastEnv = nullptr;
+    FDelegateHandle OnWorldCleanupHandle;
 };
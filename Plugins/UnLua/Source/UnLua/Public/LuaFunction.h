@@ -20,6 +20,7 @@
 namespace UnLua
 {
     class FLuaEnv;
+    class FFunctionRegistry;
 }
 
 class FFunctionDesc;
@@ -27,6 +28,8 @@ class FFunctionDesc;
 UCLASS()
 class UNLUA_API ULuaFunction : public UFunction
 {
+    friend UnLua::FFunctionRegistry;
+
     GENERATED_BODY()
 
 public:
@@ -95,4 +98,9 @@ private:
     uint8 bAdded : 1;
     uint8 bActivated : 1;
     TSharedPtr<FFunctionDesc> Desc;
+
+    // 最近一次调用所在Lua环境解析出的Lua函数，避免每次调用都查表
+    UnLua::FFunctionRegistry* CachedRegistry = nullptr;
+    int32 CachedLuaRef = 0;
+    FFunctionDesc* CachedDesc = nullptr;
 };
@@ -23,6 +23,27 @@ class UNLUA_API ULuaModuleLocator : public UObject
     GENERATED_BODY()
 public:
     virtual FString Locate(const UObject* Object);
+
+    /** Drop cached module names, called on class reinstancing and hot reload */
+    void Invalidate();
+
+protected:
+    bool FindCached(const UClass* Class, FString& OutModuleName) const;
+
+    /** Only cached in game thread, other threads read the cache with the lock held */
+    void AddCached(const UClass* Class, const FString& ModuleName);
+
+private:
+    bool FindCachedUnsafe(const UClass* Class, FString& OutModuleName) const;
+
+#if WITH_EDITOR
+    void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+    FDelegateHandle OnObjectsReplacedHandle;
+#endif
+
+    TMap<TWeakObjectPtr<const UClass>, FString> Cache;
+    mutable FCriticalSection CacheLock;
 };
 
 UCLASS()
@@ -31,8 +52,5 @@ class UNLUA_API ULuaModuleLocator_ByPackage : public ULuaModuleLocator
     GENERATED_BODY()
 public:
     virtual FString Locate(const UObject* Object) override;
-
-private:
-    TMap<FName, FString> Cache;
 };
 
@@ -44,6 +44,8 @@ public:
 
     int GetBoundRef(const UClass* Class);
 
+    void ResetInitializeRefs();
+
     void GetDefaultInputs();
 
     void CleanupDefaultInputs();
@@ -95,6 +97,12 @@ private:
     /* 将一个UClass绑定到Lua模块，根据这个模块定义的函数列表来覆盖上面的UFunction */
     bool BindClass(UClass *Class, const FString &InModuleName, FString &Error);
 
+    bool Require(UObject *Object, UClass *Class, const TCHAR *InModuleName);
+
+    bool IsClassBound(const FClassBindInfo& BindInfo) const;
+
+    int ResolveInitializeRef(FClassBindInfo& BindInfo);
+
     void ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
     void ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
     void ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
@@ -108,6 +116,7 @@ private:
         UClass* Class;
         FString ModuleName;
         int TableRef;
+        int InitializeRef = LUA_NOREF;  // LUA_NOREF: not resolved yet, LUA_REFNIL: no 'Initialize' in module
         TSet<FName> LuaFunctions;
         TMap<FName, UFunction*> UEFunctions;
     };
@@ -19,6 +19,16 @@
 #include "LuaModuleLocator.h"
 #include "UnLuaSettings.generated.h"
 
+UENUM()
+enum class ELuaGCPolicy : uint8
+{
+    /** Step incremental collector within the frame budget. */
+    Incremental,
+    /** Leave collecting to the generational collector of lua 5.4. */
+    Generational,
+    /** Generational with low allocation rate, otherwise step incremental collector within the frame budget. */
+    Adaptive,
+};
 
 UCLASS(Config=UnLuaSettings, DefaultConfig, Meta=(DisplayName="UnLua"))
 class UNLUA_API UUnLuaSettings : public UObject
@@ -40,6 +50,30 @@ public:
     UPROPERTY(Config, EditAnywhere, Category="Runtime")
     bool DanglingCheck = false;
 
+    /** Cache compiled lua chunks under Saved/UnLua/Bytecode to skip compiling unchanged files. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bEnableBytecodeCache = false;
+
+    /** Time budget in microseconds to step lua GC on every frame. Leave it 0 to let lua collect automatically. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    int32 GCBudget = 0;
+
+    /** Collector mode to use when GCBudget is set. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    ELuaGCPolicy GCPolicy = ELuaGCPolicy::Adaptive;
+
+    /** Serve small lua allocations from size-class pools instead of FMemory. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bEnablePooledAllocator = false;
+
+    /** Allocate parameter buffers of UFunction calls from a bump arena per lua env, instead of per function allocators. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bEnableParamBufferArena = false;
+
+    /** Keep lua refs of objects in a table indexed by GUObjectArray index and validated by serial number, instead of a map. Trades memory for lookups on projects with lots of objects. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bEnableDenseObjectTable = false;
+
     /** Whether to print all Lua env stacks on crash. */
     UPROPERTY(Config, EditAnywhere, Category="Runtime")
     bool bPrintLuaStackOnSystemError = true;
@@ -96,6 +96,8 @@ public class UnLua : ModuleRules
         loadBoolConfig("bEnableUnrealInsights", "ENABLE_UNREAL_INSIGHTS", false);
         loadBoolConfig("bEnableCallOverriddenFunction", "ENABLE_CALL_OVERRIDDEN_FUNCTION", true);
         loadBoolConfig("bEnableFText", "UNLUA_ENABLE_FTEXT", false);
+        loadBoolConfig("bWithDanglingCheck", "UNLUA_WITH_DANGLING_CHECK", true);
+        loadBoolConfig("bWithDeadLoopCheck", "UNLUA_WITH_DEAD_LOOP_CHECK", true);
         loadBoolConfig("bLuaCompileAsCpp", "LUA_COMPILE_AS_CPP", false);
         loadBoolConfig("bWithUE4Namespace", "WITH_UE4_NAMESPACE", true);
         loadBoolConfig("bLegacyReturnOrder", "UNLUA_LEGACY_RETURN_ORDER", false);
@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "Commandlets/UnLuaPreBindCommandlet.h"
+
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 1, 0)
+#include "AssetRegistry/AssetRegistryModule.h"
+#else
+#include "AssetRegistryModule.h"
+#endif
+#include "Engine/Blueprint.h"
+#include "LuaPreBind.h"
+#include "UnLuaBase.h"
+#include "UnLuaSettings.h"
+
+UUnLuaPreBindCommandlet::UUnLuaPreBindCommandlet(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
+
+int32 UUnLuaPreBindCommandlet::Main(const FString& Params)
+{
+    const auto& Settings = *GetDefault<UUnLuaSettings>();
+    if (!FParse::Param(*Params, TEXT("NoLoad")))
+    {
+        // blueprint classes are only found after loaded
+        const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+        AssetRegistryModule.Get().SearchAllAssets(true);
+
+        FARFilter Filter;
+        Filter.bRecursiveClasses = true;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+        Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#else
+        Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#endif
+
+        TArray<FAssetData> BlueprintAssets;
+        AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
+        for (const auto& Asset : BlueprintAssets)
+            Asset.GetAsset();
+    }
+
+    UnLua::FPreBindManifest Manifest;
+    Manifest.Collect(Settings.PreBindClasses, Settings.ModuleLocatorClass.GetDefaultObject());
+
+    const auto Path = UnLua::FPreBindManifest::GetPath();
+    if (!Manifest.Save(Path))
+    {
+        UE_LOG(LogUnLua, Error, TEXT("Failed to save prebind manifest to %s."), *Path);
+        return 1;
+    }
+
+    UE_LOG(LogUnLua, Display, TEXT("%d classes saved to prebind manifest %s."), Manifest.Entries.Num(), *Path);
+    return 0;
+}
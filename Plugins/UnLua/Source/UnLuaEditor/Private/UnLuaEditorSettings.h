@@ -78,6 +78,14 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Build")
     bool bEnableFText = true;
 
+    /** Compile in dangling pointer check, it still needs to be enabled in runtime settings. (Requires restart to take effect) */
+    UPROPERTY(config, EditAnywhere, Category = "Build")
+    bool bWithDanglingCheck = true;
+
+    /** Compile in dead loop check, it still needs to be enabled in runtime settings. (Requires restart to take effect) */
+    UPROPERTY(config, EditAnywhere, Category = "Build")
+    bool bWithDeadLoopCheck = true;
+
     /** Whether or not compile lua module as c++ code. (Requires restart to take effect) */
     UPROPERTY(config, EditAnywhere, Category = "Build")
     bool bLuaCompileAsCpp = false;
@@ -0,0 +1,125 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Engine.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+#include "Perfs/UnLuaBenchmarkProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FArrayConversionBenchmarkSpec, "UnLua.Benchmark.ArrayConversion", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+    UWorld* World;
+    AUnLuaBenchmarkProxy* Proxy;
+    void RunChunk(const FString& Title, int32 N, const FString& Body);
+END_DEFINE_SPEC(FArrayConversionBenchmarkSpec)
+
+void FArrayConversionBenchmarkSpec::RunChunk(const FString& Title, int32 N, const FString& Body)
+{
+    const auto Chunk = FString::Printf(TEXT(R"(
+        local Proxy, Indices, Positions, IndexTable, PositionTable = Proxy, Proxy.Indices, Proxy.Positions, IndexTable, PositionTable
+        for i = 1, %d do
+            %s
+        end
+    )"), N, *Body);
+    const FTCHARToUTF8 Bytes(*Chunk);
+    if (luaL_loadbuffer(L, Bytes.Get(), Bytes.Length(), TCHAR_TO_UTF8(*Title)) != LUA_OK)
+    {
+        AddError(FString::Printf(TEXT("%s: %s"), *Title, UTF8_TO_TCHAR(lua_tostring(L, -1))));
+        lua_pop(L, 1);
+        return;
+    }
+
+    UUnLuaBenchmarkFunctionLibrary::StartTimer(Title);
+    const auto Status = lua_pcall(L, 0, 0, 0);
+    UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+    if (Status != LUA_OK)
+    {
+        AddError(FString::Printf(TEXT("%s: %s"), *Title, UTF8_TO_TCHAR(lua_tostring(L, -1))));
+        lua_pop(L, 1);
+    }
+}
+
+void FArrayConversionBenchmarkSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+        UUnLuaBenchmarkFunctionLibrary::SetEnv(Env.Get());
+
+        World = UWorld::CreateWorld(EWorldType::Game, false, "UnLuaTest");
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        const FURL URL;
+        World->InitializeActorsForPlay(URL);
+        World->BeginPlay();
+
+        Proxy = World->SpawnActor<AUnLuaBenchmarkProxy>();
+        UnLua::PushUObject(L, Proxy);
+        lua_setglobal(L, "Proxy");
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    });
+
+    It(TEXT("对比不同元素数量时数组与LuaTable互转的开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        const int32 Sizes[] = {10, 1000, 100000};
+        for (const auto Size : Sizes)
+        {
+            Proxy->Indices.SetNum(Size);
+            Proxy->Positions.SetNum(Size);
+            for (int32 i = 0; i < Size; i++)
+            {
+                Proxy->Indices[i] = i;
+                Proxy->Positions[i] = FVector(i, i, i);
+            }
+
+            const auto Prepare = FString::Printf(TEXT(R"(
+                IndexTable = Proxy.Indices:ToTable()
+                PositionTable = Proxy.Positions:ToTable()
+                assert(#IndexTable == %d and #PositionTable == %d)
+            )"), Size, Size);
+            TEST_TRUE(Env->DoString(Prepare));
+
+            // same amount of elements converted for every size
+            const int32 N = FMath::Max(1000000 / Size, 10);
+            UUnLuaBenchmarkFunctionLibrary::Start(FString::Printf(TEXT("ArrayConversion_%d"), Size), N);
+            RunChunk(TEXT("TArray<int32>->table"), N, TEXT("Indices:ToTable()"));
+            RunChunk(TEXT("TArray<FVector>->table"), N, TEXT("Positions:ToTable()"));
+            RunChunk(TEXT("table->TArray<int32>"), N, TEXT("Proxy.Indices = IndexTable"));
+            RunChunk(TEXT("table->TArray<FVector>"), N, TEXT("Proxy.Positions = PositionTable"));
+            UUnLuaBenchmarkFunctionLibrary::Stop();
+
+            TEST_EQUAL(Proxy->Indices.Num(), Size);
+            TEST_EQUAL(Proxy->Positions.Num(), Size);
+            Env->GC();
+        }
+    });
+}
+
+#endif
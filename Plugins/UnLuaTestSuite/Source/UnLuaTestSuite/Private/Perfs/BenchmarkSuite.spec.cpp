@@ -0,0 +1,190 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLua.h"
+#include "UnLuaTestHelpers.h"
+#include "Engine.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+#include "Perfs/UnLuaBenchmarkProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FBenchmarkSuiteSpec, "UnLua.Benchmark.Suite", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+    UWorld* World;
+    AUnLuaBenchmarkProxy* Proxy;
+    void RunChunk(const FString& Title, const FString& Body);
+END_DEFINE_SPEC(FBenchmarkSuiteSpec)
+
+static constexpr int32 N = 100000;
+
+static int32 LoadBenchmarkModule(lua_State* L)
+{
+    lua_newtable(L);
+    return 1;
+}
+
+void FBenchmarkSuiteSpec::RunChunk(const FString& Title, const FString& Body)
+{
+    const auto Chunk = FString::Printf(TEXT(R"(
+        local Proxy, Vector, Object, Table, Indices = Proxy, Vector, Object, Table, Indices
+        for i = 1, %d do
+            %s
+        end
+    )"), N, *Body);
+    const FTCHARToUTF8 Bytes(*Chunk);
+    if (luaL_loadbuffer(L, Bytes.Get(), Bytes.Length(), TCHAR_TO_UTF8(*Title)) != LUA_OK)
+    {
+        AddError(FString::Printf(TEXT("%s: %s"), *Title, UTF8_TO_TCHAR(lua_tostring(L, -1))));
+        lua_pop(L, 1);
+        return;
+    }
+
+    UUnLuaBenchmarkFunctionLibrary::StartTimer(Title);
+    const auto Status = lua_pcall(L, 0, 0, 0);
+    UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+    if (Status != LUA_OK)
+    {
+        AddError(FString::Printf(TEXT("%s: %s"), *Title, UTF8_TO_TCHAR(lua_tostring(L, -1))));
+        lua_pop(L, 1);
+    }
+}
+
+void FBenchmarkSuiteSpec::Define()
+{
+    BeforeEach([this]
+    {
+        // pooled allocator counts lua allocations of every case
+        Env = MakeShared<UnLua::FLuaEnv>(UnLua::ELuaAllocator::Pooled);
+        L = Env->GetMainState();
+        UUnLuaBenchmarkFunctionLibrary::SetEnv(Env.Get());
+
+        World = UWorld::CreateWorld(EWorldType::Game, false, "UnLuaTest");
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        const FURL URL;
+        World->InitializeActorsForPlay(URL);
+        World->BeginPlay();
+
+        Proxy = World->SpawnActor<AUnLuaBenchmarkProxy>();
+        for (int32 i = 0; i < 64; i++)
+            Proxy->Indices.Add(i);
+
+        UnLua::PushUObject(L, Proxy);
+        lua_setglobal(L, "Proxy");
+
+        const auto Prepare = R"(
+            Vector = UE.FVector(1, 2, 3)
+            Object = Proxy
+            Indices = Proxy.Indices
+            Table = {}
+            for i = 1, 64 do Table[i] = i end
+            function F0() end
+            function F4(a, b, c, d) end
+            function F16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) end
+            Proxy.OnEvent:Add(Proxy, function(Self, Value) end)
+        )";
+        TEST_TRUE(Env->DoString(Prepare));
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    });
+
+    It(TEXT("Lua与UE互调、属性读写、容器转换、委托广播、对象Push和require"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("Suite"), N);
+
+        // Lua -> UE
+        RunChunk(TEXT("Lua->UE 0 params"), TEXT("Proxy:NOP()"));
+        RunChunk(TEXT("Lua->UE 4 params"), TEXT("Proxy:Sum4(1, 2, 3, 4)"));
+        RunChunk(TEXT("Lua->UE 16 params"), TEXT("Proxy:Sum16(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16)"));
+
+        // UE -> Lua
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("UE->Lua 0 params"));
+        for (int32 i = 0; i < N; i++)
+            UnLua::Call(L, "F0");
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("UE->Lua 4 params"));
+        for (int32 i = 0; i < N; i++)
+            UnLua::Call(L, "F4", 1, 2, 3, 4);
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("UE->Lua 16 params"));
+        for (int32 i = 0; i < N; i++)
+            UnLua::Call(L, "F16", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        // properties
+        const TCHAR* Properties[][3] =
+        {
+            {TEXT("bool"), TEXT("bEnabled"), TEXT("true")},
+            {TEXT("int32"), TEXT("MeshID"), TEXT("i")},
+            {TEXT("float"), TEXT("Weight"), TEXT("0.5")},
+            {TEXT("FName"), TEXT("Tag"), TEXT("'Socket'")},
+            {TEXT("FString"), TEXT("MeshName"), TEXT("'Mesh'")},
+            {TEXT("FVector"), TEXT("COM"), TEXT("Vector")},
+            {TEXT("UObject"), TEXT("Target"), TEXT("Object")},
+        };
+        for (const auto& Property : Properties)
+        {
+            RunChunk(FString::Printf(TEXT("read %s"), Property[0]), FString::Printf(TEXT("local _ = Proxy.%s"), Property[1]));
+            RunChunk(FString::Printf(TEXT("write %s"), Property[0]), FString::Printf(TEXT("Proxy.%s = %s"), Property[1], Property[2]));
+        }
+
+        // containers
+        RunChunk(TEXT("TArray<int32> ToTable with 64 items"), TEXT("local _ = Indices:ToTable()"));
+        RunChunk(TEXT("TArray<int32> FromTable with 64 items"), TEXT("Proxy.Indices = Table"));
+
+        // delegate
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("delegate broadcast"));
+        for (int32 i = 0; i < N; i++)
+            Proxy->OnEvent.Broadcast(i);
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        // object push
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("push UObject"));
+        for (int32 i = 0; i < N; i++)
+        {
+            UnLua::PushUObject(L, Proxy);
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        // require
+        Env->AddBuiltInLoader(TEXT("BenchmarkSuiteModule"), LoadBenchmarkModule);
+        RunChunk(TEXT("require loaded module"), TEXT("require('BenchmarkSuiteModule')"));
+        RunChunk(TEXT("require module"), TEXT("package.loaded['BenchmarkSuiteModule'] = nil require('BenchmarkSuiteModule')"));
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+
+        for (const auto& Result : UUnLuaBenchmarkFunctionLibrary::GetResults())
+        {
+            AddInfo(FString::Printf(TEXT("%s: %.2f ns/op, %.0f ops/sec, %lld allocations, %lld bytes heap delta"),
+                                    *Result.Title, Result.NsPerOp, Result.OpsPerSec, Result.Allocations, Result.HeapDelta));
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Engine.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+#include "Perfs/UnLuaBenchmarkProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FCallLuaGuardBenchmarkSpec, "UnLua.Benchmark.CallLuaGuard", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    UWorld* World;
+    AUnLuaBenchmarkProxy* Proxy;
+END_DEFINE_SPEC(FCallLuaGuardBenchmarkSpec)
+
+void FCallLuaGuardBenchmarkSpec::Define()
+{
+    static constexpr int32 N = 1000000;
+
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        const auto L = Env->GetMainState();
+
+        World = UWorld::CreateWorld(EWorldType::Game, false, "UnLuaTest");
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        const FURL URL;
+        World->InitializeActorsForPlay(URL);
+        World->BeginPlay();
+
+        Proxy = World->SpawnActor<AUnLuaBenchmarkProxy>();
+        UnLua::PushUObject(L, Proxy);
+        lua_setglobal(L, "Proxy");
+        TEST_TRUE(Env->DoString(TEXT("Proxy.OnEvent:Add(Proxy, function(Self, Value) end)")));
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    });
+
+    It(TEXT("对比开启和关闭悬垂指针检查、死循环检查时UE调用Lua的开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        const auto DanglingCheck = UnLua::FDanglingCheck::Enabled;
+        const auto Timeout = UnLua::FDeadLoopCheck::Timeout;
+
+        struct FCase
+        {
+            const TCHAR* Title;
+            bool bDanglingCheck;
+            int32 Timeout;
+        };
+
+        const FCase Cases[] =
+        {
+            {TEXT("NoCheck"), false, 0},
+            {TEXT("DanglingCheck"), true, 0},
+            {TEXT("DeadLoopCheck"), false, 10},
+            {TEXT("BothChecks"), true, 10},
+        };
+
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("CallLuaGuard"), N);
+
+        for (const auto& Case : Cases)
+        {
+            UnLua::FDanglingCheck::Enabled = Case.bDanglingCheck;
+            UnLua::FDeadLoopCheck::Timeout = Case.Timeout;
+
+            UUnLuaBenchmarkFunctionLibrary::StartTimer(Case.Title);
+            for (int32 i = 0; i < N; i++)
+                Proxy->OnEvent.Broadcast(i);
+            UUnLuaBenchmarkFunctionLibrary::StopTimer();
+        }
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+
+        UnLua::FDanglingCheck::Enabled = DanglingCheck;
+        UnLua::FDeadLoopCheck::Timeout = Timeout;
+    });
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMathBenchmarkSpec, "UnLua.Benchmark.Math", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+END_DEFINE_SPEC(FMathBenchmarkSpec)
+
+void FMathBenchmarkSpec::Define()
+{
+    static constexpr int32 N = 1000000;
+
+    BeforeEach([this]
+    {
+        // pooled allocator counts every block, so allocations per op can be reported
+        Env = MakeShared<UnLua::FLuaEnv>(UnLua::ELuaAllocator::Pooled);
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+    });
+
+    It(TEXT("对比新建结果、原地计算和写入Out的FVector运算开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        const auto Allocator = Env->GetPoolAllocator();
+        TEST_TRUE(Allocator != nullptr);
+
+        TEST_TRUE(Env->DoString(TEXT(R"(
+            A = UE.FVector(1, 2, 3)
+            B = UE.FVector(4, 5, 6)
+            Out = UE.FVector()
+        )")));
+        Env->GC();
+
+        struct FCase
+        {
+            const TCHAR* Title;
+            const TCHAR* Expression;
+        };
+
+        const FCase Cases[] =
+        {
+            {TEXT("NewResult"), TEXT("local C = A + B")},
+            {TEXT("InPlace"), TEXT("A:AddInPlace(B)")},
+            {TEXT("OutParam"), TEXT("Add(Out, A, B)")},
+            {TEXT("RotatorNewResult"), TEXT("local C = R + R")},
+            {TEXT("RotatorOutParam"), TEXT("RAdd(ROut, R, R)")},
+        };
+
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("Math"), N);
+
+        for (const auto& Case : Cases)
+        {
+            const auto Chunk = FString::Printf(TEXT(R"(
+                collectgarbage("stop")
+                local A, B, Out, Add = A, B, Out, UE.FVector.AddInPlace
+                local R, ROut, RAdd = UE.FRotator(1, 2, 3), UE.FRotator(), UE.FRotator.AddInPlace
+                for i = 1, %d do
+                    %s
+                end
+                collectgarbage("restart")
+            )"), N, Case.Expression);
+
+            const auto AllocsBefore = Allocator->GetStats().SmallAllocs + Allocator->GetStats().LargeAllocs;
+            UUnLuaBenchmarkFunctionLibrary::StartTimer(Case.Title);
+            TEST_TRUE(Env->DoString(Chunk));
+            UUnLuaBenchmarkFunctionLibrary::StopTimer();
+            const auto Allocs = Allocator->GetStats().SmallAllocs + Allocator->GetStats().LargeAllocs - AllocsBefore;
+            AddInfo(FString::Printf(TEXT("%s: %llu allocations per %d ops"), Case.Title, (uint64)Allocs, N));
+
+            // only the chunk itself and the two rotators, nothing per op
+            if (FCString::Strstr(Case.Title, TEXT("NewResult")) == nullptr)
+                TEST_TRUE(Allocs < 1000);
+
+            Env->GC();
+        }
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+    });
+}
+
+#endif
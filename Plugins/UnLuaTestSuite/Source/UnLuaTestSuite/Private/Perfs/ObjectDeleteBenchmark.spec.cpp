@@ -0,0 +1,92 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FObjectDeleteBenchmarkSpec, "UnLua.Benchmark.ObjectDelete", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+    TArray<UObject*> Objects;
+    void CreateObjects();
+    void NotifyDeleted(const FString& Title);
+END_DEFINE_SPEC(FObjectDeleteBenchmarkSpec)
+
+static constexpr int32 N = 100000;
+
+void FObjectDeleteBenchmarkSpec::CreateObjects()
+{
+    Objects.Reset(N);
+    for (int32 i = 0; i < N; i++)
+        Objects.Add(NewObject<UUnLuaTestStub>());
+}
+
+void FObjectDeleteBenchmarkSpec::NotifyDeleted(const FString& Title)
+{
+    UUnLuaBenchmarkFunctionLibrary::StartTimer(Title);
+    for (const auto Object : Objects)
+        Env->NotifyUObjectDeleted(Object, GUObjectArray.ObjectToIndex(Object));
+    UUnLuaBenchmarkFunctionLibrary::StopTimer();
+}
+
+void FObjectDeleteBenchmarkSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+        UUnLuaBenchmarkFunctionLibrary::SetEnv(Env.Get());
+    });
+
+    AfterEach([this]
+    {
+        Objects.Empty();
+        Env.Reset();
+        L = nullptr;
+        CollectGarbage(RF_NoFlags, true);
+    });
+
+    It(TEXT("对比Lua未引用和已引用对象的删除通知开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("ObjectDelete"), N);
+
+        CreateObjects();
+        NotifyDeleted(TEXT("NotifyUntouched"));
+
+        for (const auto Object : Objects)
+        {
+            UnLua::PushUObject(L, Object);
+            lua_pop(L, 1);
+        }
+        NotifyDeleted(TEXT("NotifyTouched"));
+
+        // real deletion of unbound objects, including the rest of UE GC
+        CreateObjects();
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("DestroyUnbound"));
+        Objects.Reset();
+        CollectGarbage(RF_NoFlags, true);
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        TEST_TRUE(Env->GetTouchedObjects()->GetStats().Skipped >= 2 * N);
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+    });
+}
+
+#endif
@@ -0,0 +1,90 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaCore.h"
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FPushObjectBenchmarkSpec, "UnLua.Benchmark.PushObject", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FPushObjectBenchmarkSpec)
+
+void FPushObjectBenchmarkSpec::Define()
+{
+    static constexpr int32 N = 1000000;
+
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    It(TEXT("对比按名字查找元表和按缓存引用获取元表的Push开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UObject* Object = GetMutableDefault<UUnLuaTestStub>();
+        const UClass* Class = Object->GetClass();
+
+        // warm up, make sure the metatable is registered and pinned
+        PushObjectCore(L, Object);
+        TEST_TRUE(lua_isuserdata(L, -1));
+        lua_pop(L, 1);
+
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("PushObject"), N);
+
+        // the lookup every push used to do before metatable refs were cached
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("GetMetatableByName"));
+        for (int32 i = 0; i < N; i++)
+        {
+            const FString MetatableName = FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName());
+            luaL_getmetatable(L, TCHAR_TO_UTF8(*MetatableName));
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        luaL_getmetatable(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("%s%s"), Class->GetPrefixCPP(), *Class->GetName())));
+        const int32 MetatableRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("GetMetatableByRef"));
+        for (int32 i = 0; i < N; i++)
+        {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, MetatableRef);
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+        luaL_unref(L, LUA_REGISTRYINDEX, MetatableRef);
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("PushObjectCore"));
+        for (int32 i = 0; i < N; i++)
+        {
+            PushObjectCore(L, Object);
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+        lua_gc(L, LUA_GCCOLLECT, 0);
+    });
+}
+
+#endif
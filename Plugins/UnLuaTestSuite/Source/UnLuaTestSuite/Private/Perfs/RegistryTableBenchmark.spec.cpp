@@ -0,0 +1,106 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRegistryTableBenchmarkSpec, "UnLua.Benchmark.RegistryTable", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+END_DEFINE_SPEC(FRegistryTableBenchmarkSpec)
+
+void FRegistryTableBenchmarkSpec::Define()
+{
+    static constexpr int32 N = 1000000;
+
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+    });
+
+    It(TEXT("对比按名字和按引用获取内部缓存表的开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UnLua::FLuaEnv::FindEnvChecked(L).PushRegistryTable(L, UnLua::ERegistryTable::ObjectMap);
+        lua_getfield(L, LUA_REGISTRYINDEX, "UnLua_ObjectMap");
+        TEST_TRUE(lua_rawequal(L, -1, -2));
+        lua_pop(L, 2);
+
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("RegistryTable"), N);
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("GetRegistryTableByName"));
+        for (int32 i = 0; i < N; i++)
+        {
+            lua_getfield(L, LUA_REGISTRYINDEX, "UnLua_ObjectMap");
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("GetRegistryTableByRef"));
+        for (int32 i = 0; i < N; i++)
+        {
+            UnLua::FLuaEnv::FindEnvChecked(L).PushRegistryTable(L, UnLua::ERegistryTable::ObjectMap);
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+    });
+
+    It(TEXT("测试对象和容器的Push吞吐"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UObject* Object = NewObject<UUnLuaTestStub>();
+        Object->AddToRoot();
+
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("PushObjectAndContainer"), N);
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("PushObject"));
+        for (int32 i = 0; i < N; i++)
+        {
+            UnLua::PushUObject(L, Object, false);
+            lua_pop(L, 1);
+        }
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UnLua::PushUObject(L, Object, false);
+        lua_setglobal(L, "Stub");
+        const auto Chunk = FString::Printf(TEXT(R"(
+            local Stub = Stub
+            for i = 1, %d do
+                local _ = Stub.MapForIssue407
+            end
+        )"), N);
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("PushContainer"));
+        TEST_TRUE(Env->DoString(Chunk));
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+
+        lua_pushnil(L);
+        lua_setglobal(L, "Stub");
+        Object->RemoveFromRoot();
+    });
+}
+
+#endif
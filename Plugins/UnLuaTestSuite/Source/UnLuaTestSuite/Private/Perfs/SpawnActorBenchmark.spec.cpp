@@ -0,0 +1,91 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "UnLuaBase.h"
+#include "UnLuaTestHelpers.h"
+#include "Engine.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FSpawnActorBenchmarkSpec, "UnLua.Benchmark.SpawnActor", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    lua_State* L;
+    UWorld* World;
+END_DEFINE_SPEC(FSpawnActorBenchmarkSpec)
+
+void FSpawnActorBenchmarkSpec::Define()
+{
+    static constexpr int32 N = 10000;
+
+    BeforeEach([this]
+    {
+        UnLua::Startup();
+        L = UnLua::GetState();
+
+        World = UWorld::CreateWorld(EWorldType::Game, false, "UnLuaTest");
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        const FURL URL;
+        World->InitializeActorsForPlay(URL);
+        World->BeginPlay();
+
+        UnLua::PushUObject(L, World);
+        lua_setglobal(L, "World");
+    });
+
+    AfterEach([this]
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        UnLua::Shutdown();
+    });
+
+    It(TEXT("对比创建未绑定和已绑定Lua模块的Actor的开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        const auto Chunk = R"(
+            N = ...
+            Transform = UE.FTransform()
+            Spawn = function(ModuleName)
+                for i = 1, N do
+                    World:SpawnActor(UE.AActor, Transform, UE.ESpawnActorCollisionHandlingMethod.AlwaysSpawn, nil, nil, ModuleName)
+                end
+            end
+            local Actor = World:SpawnActor(UE.AActor, Transform, UE.ESpawnActorCollisionHandlingMethod.AlwaysSpawn, nil, nil, 'Tests.Binding.BP_UnLuaTestActor')
+            return Actor.InitializeCalled
+        )";
+        lua_pushinteger(L, N);
+        TEST_TRUE(luaL_loadstring(L, Chunk) == LUA_OK);
+        lua_insert(L, -2);
+        TEST_TRUE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+        TEST_TRUE(!!lua_toboolean(L, -1));
+        lua_pop(L, 1);
+
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("SpawnActor"), N);
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("SpawnActor"));
+        UnLua::RunChunk(L, "Spawn()");
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::StartTimer(TEXT("SpawnBoundActor"));
+        UnLua::RunChunk(L, "Spawn('Tests.Binding.BP_UnLuaTestActor')");
+        UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+    });
+}
+
+#endif
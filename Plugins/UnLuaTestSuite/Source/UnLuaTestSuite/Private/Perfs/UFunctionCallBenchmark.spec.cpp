@@ -0,0 +1,124 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "LuaEnv.h"
+#include "UnLuaTestHelpers.h"
+#include "Engine.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+#include "Perfs/UnLuaBenchmarkProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FUFunctionCallBenchmarkSpec, "UnLua.Benchmark.UFunctionCall", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+    lua_State* L;
+    UWorld* World;
+    AUnLuaBenchmarkProxy* Proxy;
+    void RunChunk(const FString& Title, const FString& Body);
+END_DEFINE_SPEC(FUFunctionCallBenchmarkSpec)
+
+static constexpr int32 N = 1000000;
+
+/**
+ * Per call overhead of the closures before function descriptors were passed as raw pointers:
+ * env lookup and a copy of the shared ptr pinned by the closure
+ */
+static int32 ResolveFunctionDescByRegistry(lua_State* L)
+{
+    auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
+    const auto Function = Env.GetObjectRegistry()->Get<void>(L, lua_upvalueindex(1));
+    lua_pushboolean(L, Function.IsValid());
+    return 1;
+}
+
+void FUFunctionCallBenchmarkSpec::RunChunk(const FString& Title, const FString& Body)
+{
+    const auto Chunk = FString::Printf(TEXT(R"(
+        local Proxy, StaticNOP, Resolve = Proxy, UE.AUnLuaBenchmarkProxy.StaticNOP, Resolve
+        for i = 1, %d do
+            %s
+        end
+    )"), N, *Body);
+    const FTCHARToUTF8 Bytes(*Chunk);
+    if (luaL_loadbuffer(L, Bytes.Get(), Bytes.Length(), TCHAR_TO_UTF8(*Title)) != LUA_OK)
+    {
+        AddError(FString::Printf(TEXT("%s: %s"), *Title, UTF8_TO_TCHAR(lua_tostring(L, -1))));
+        lua_pop(L, 1);
+        return;
+    }
+
+    UUnLuaBenchmarkFunctionLibrary::StartTimer(Title);
+    const auto Status = lua_pcall(L, 0, 0, 0);
+    UUnLuaBenchmarkFunctionLibrary::StopTimer();
+
+    if (Status != LUA_OK)
+    {
+        AddError(FString::Printf(TEXT("%s: %s"), *Title, UTF8_TO_TCHAR(lua_tostring(L, -1))));
+        lua_pop(L, 1);
+    }
+}
+
+void FUFunctionCallBenchmarkSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+        L = Env->GetMainState();
+        UUnLuaBenchmarkFunctionLibrary::SetEnv(Env.Get());
+
+        World = UWorld::CreateWorld(EWorldType::Game, false, "UnLuaTest");
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        const FURL URL;
+        World->InitializeActorsForPlay(URL);
+        World->BeginPlay();
+
+        Proxy = World->SpawnActor<AUnLuaBenchmarkProxy>();
+        UnLua::PushUObject(L, Proxy);
+        lua_setglobal(L, "Proxy");
+
+        // the descriptor anchor is the last upvalue of the generated closure
+        TEST_TRUE(Env->DoString(TEXT("NOP = Proxy.NOP")));
+        lua_getglobal(L, "NOP");
+        TEST_TRUE(lua_iscfunction(L, -1));
+        TEST_TRUE(lua_getupvalue(L, -1, 3) != nullptr);
+        lua_pushcclosure(L, ResolveFunctionDescByRegistry, 1);
+        lua_setglobal(L, "Resolve");
+        lua_pop(L, 1);
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+        L = nullptr;
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    });
+
+    It(TEXT("对比成员函数、静态函数的调用开销和旧版查找函数描述的开销"), EAsyncExecution::TaskGraphMainThread, [this]()
+    {
+        UUnLuaBenchmarkFunctionLibrary::Start(TEXT("UFunctionCall"), N);
+
+        RunChunk(TEXT("ResolveByRegistry"), TEXT("Resolve()"));
+        RunChunk(TEXT("MemberNOP"), TEXT("Proxy:NOP()"));
+        RunChunk(TEXT("StaticNOP"), TEXT("StaticNOP()"));
+
+        UUnLuaBenchmarkFunctionLibrary::Stop();
+    });
+}
+
+#endif
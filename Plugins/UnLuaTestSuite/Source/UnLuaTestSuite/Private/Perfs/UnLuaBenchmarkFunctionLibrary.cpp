@@ -13,39 +13,182 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "Perfs/UnLuaBenchmarkFunctionLibrary.h"
+#include "Dom/JsonObject.h"
+#include "Misc/CommandLine.h"
 #include "Misc/DateTime.h"
 #include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "LuaEnv.h"
+#include "UnLuaModule.h"
 
 double UUnLuaBenchmarkFunctionLibrary::StartTime;
 FString UUnLuaBenchmarkFunctionLibrary::StartTitle;
+int64 UUnLuaBenchmarkFunctionLibrary::StartAllocations;
+int64 UUnLuaBenchmarkFunctionLibrary::StartHeap;
 float UUnLuaBenchmarkFunctionLibrary::BenchmarkMultiplier;
 FString UUnLuaBenchmarkFunctionLibrary::BenchmarkTitle;
+int32 UUnLuaBenchmarkFunctionLibrary::BenchmarkN;
 TArray<FString> UUnLuaBenchmarkFunctionLibrary::Messages;
+TArray<FUnLuaBenchmarkResult> UUnLuaBenchmarkFunctionLibrary::Results;
+UnLua::FLuaEnv* UUnLuaBenchmarkFunctionLibrary::Env;
+float UUnLuaBenchmarkFunctionLibrary::RegressionThreshold = 0.1f;
 
 void UUnLuaBenchmarkFunctionLibrary::Start(const FString& Title, const int32 N)
 {
     BenchmarkTitle = Title;
+    BenchmarkN = N;
     BenchmarkMultiplier = 1000000000.0f / N;
     Messages.Reset();
+    Results.Reset();
     FBlueprintCoreDelegates::SetScriptMaximumLoopIterations(0x7FFFFFFF);
 }
 
 void UUnLuaBenchmarkFunctionLibrary::StartTimer(const FString& Title)
 {
-    StartTime = FPlatformTime::Seconds();
+    GetLuaCounters(StartAllocations, StartHeap);
     StartTitle = Title;
+    StartTime = FPlatformTime::Seconds();
 }
 
 void UUnLuaBenchmarkFunctionLibrary::StopTimer()
 {
-    const auto Cost = (FPlatformTime::Seconds() - StartTime) * BenchmarkMultiplier;
+    const auto Seconds = FPlatformTime::Seconds() - StartTime;
+    const auto Cost = Seconds * BenchmarkMultiplier;
     const auto Message = FString::Printf(TEXT("%s ; %f"), *StartTitle, Cost);
     Messages.Add(Message);
+
+    int64 Allocations, Heap;
+    GetLuaCounters(Allocations, Heap);
+
+    auto& Result = Results.AddDefaulted_GetRef();
+    Result.Title = StartTitle;
+    Result.N = BenchmarkN;
+    Result.NsPerOp = Cost;
+    Result.OpsPerSec = Seconds > 0 ? BenchmarkN / Seconds : 0;
+    Result.Allocations = Allocations < 0 ? -1 : Allocations - StartAllocations;
+    Result.HeapDelta = Heap - StartHeap;
 }
 
 void UUnLuaBenchmarkFunctionLibrary::Stop()
 {
     const auto Message = FString::Join(Messages, TEXT("\n"));
-    const auto FilePath = FString::Printf(TEXT("%sBenchmark/%s-Benchmark-%s.csv"), *FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir()), *BenchmarkTitle, *FDateTime::Now().ToString());
-    FFileHelper::SaveStringToFile(Message, *FilePath);
+    const auto FilePathBase = FString::Printf(TEXT("%sBenchmark/%s-Benchmark-%s"), *FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir()), *BenchmarkTitle, *FDateTime::Now().ToString());
+    FFileHelper::SaveStringToFile(Message, *(FilePathBase + TEXT(".csv")));
+
+    TArray<TSharedPtr<FJsonValue>> Cases;
+    for (const auto& Result : Results)
+    {
+        const auto Case = MakeShared<FJsonObject>();
+        Case->SetStringField(TEXT("Title"), Result.Title);
+        Case->SetNumberField(TEXT("N"), Result.N);
+        Case->SetNumberField(TEXT("NsPerOp"), Result.NsPerOp);
+        Case->SetNumberField(TEXT("OpsPerSec"), Result.OpsPerSec);
+        Case->SetNumberField(TEXT("Allocations"), Result.Allocations);
+        Case->SetNumberField(TEXT("HeapDelta"), Result.HeapDelta);
+        Cases.Add(MakeShared<FJsonValueObject>(Case));
+    }
+
+    const auto Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("Title"), BenchmarkTitle);
+    Root->SetStringField(TEXT("Date"), FDateTime::Now().ToIso8601());
+    Root->SetArrayField(TEXT("Cases"), Cases);
+
+    FString Json;
+    const auto Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+    FFileHelper::SaveStringToFile(Json, *(FilePathBase + TEXT(".json")));
+
+    const auto BaselinePath = GetBaselinePath(BenchmarkTitle);
+    if (FParse::Param(FCommandLine::Get(), TEXT("UnLuaBenchmarkSaveBaseline")))
+    {
+        FFileHelper::SaveStringToFile(Json, *BaselinePath);
+        UE_LOG(LogUnLua, Log, TEXT("benchmark baseline saved to %s"), *BaselinePath);
+    }
+    else if (FPaths::FileExists(BaselinePath))
+    {
+        const auto Regressions = CompareWithBaseline(BaselinePath);
+        for (const auto& Regression : Regressions)
+            UE_LOG(LogUnLua, Warning, TEXT("benchmark regression in %s: %s"), *BenchmarkTitle, *Regression);
+        UE_LOG(LogUnLua, Log, TEXT("%s compared with baseline %s, %d regressions found."), *BenchmarkTitle, *BaselinePath, Regressions.Num());
+    }
+
+    Env = nullptr;
+}
+
+void UUnLuaBenchmarkFunctionLibrary::SetEnv(UnLua::FLuaEnv* InEnv)
+{
+    Env = InEnv;
+}
+
+TArray<FString> UUnLuaBenchmarkFunctionLibrary::CompareWithBaseline(const FString& BaselinePath)
+{
+    TArray<FString> Regressions;
+
+    FString Json;
+    TSharedPtr<FJsonObject> Root;
+    if (!FFileHelper::LoadFileToString(Json, *BaselinePath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+    {
+        Regressions.Add(FString::Printf(TEXT("invalid baseline %s"), *BaselinePath));
+        return Regressions;
+    }
+
+    float Threshold = RegressionThreshold;
+    FParse::Value(FCommandLine::Get(), TEXT("UnLuaBenchmarkThreshold="), Threshold);
+
+    TMap<FString, TSharedPtr<FJsonObject>> Baselines;
+    for (const auto& Value : Root->GetArrayField(TEXT("Cases")))
+    {
+        const auto Case = Value->AsObject();
+        Baselines.Add(Case->GetStringField(TEXT("Title")), Case);
+    }
+
+    for (const auto& Result : Results)
+    {
+        const auto Baseline = Baselines.FindRef(Result.Title);
+        if (!Baseline.IsValid())
+            continue;
+
+        const auto BaselineNsPerOp = Baseline->GetNumberField(TEXT("NsPerOp"));
+        if (BaselineNsPerOp > 0 && Result.NsPerOp > BaselineNsPerOp * (1 + Threshold))
+        {
+            Regressions.Add(FString::Printf(TEXT("%s %.2f ns/op, baseline %.2f ns/op (+%.1f%%)"), *Result.Title, Result.NsPerOp, BaselineNsPerOp,
+                                            (Result.NsPerOp / BaselineNsPerOp - 1) * 100));
+        }
+
+        const auto BaselineAllocations = (int64)Baseline->GetNumberField(TEXT("Allocations"));
+        if (BaselineAllocations >= 0 && Result.Allocations > BaselineAllocations)
+        {
+            Regressions.Add(FString::Printf(TEXT("%s %lld allocations, baseline %lld"), *Result.Title, Result.Allocations, BaselineAllocations));
+        }
+    }
+
+    return Regressions;
+}
+
+FString UUnLuaBenchmarkFunctionLibrary::GetBaselinePath(const FString& Title)
+{
+    FString Dir;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("UnLuaBenchmarkBaseline="), Dir))
+        Dir = FPaths::ProjectSavedDir() / TEXT("Benchmark/Baseline");
+    return FPaths::ConvertRelativePathToFull(Dir / (Title + TEXT(".json")));
+}
+
+void UUnLuaBenchmarkFunctionLibrary::GetLuaCounters(int64& OutAllocations, int64& OutHeap)
+{
+    OutAllocations = -1;
+    OutHeap = 0;
+
+    const auto CurrentEnv = Env ? Env : IUnLuaModule::Get().GetEnv();
+    if (!CurrentEnv)
+        return;
+
+    const auto L = CurrentEnv->GetMainState();
+    OutHeap = (int64)lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+
+    if (const auto Allocator = CurrentEnv->GetPoolAllocator())
+    {
+        const auto& Stats = Allocator->GetStats();
+        OutAllocations = Stats.SmallAllocs + Stats.LargeAllocs;
+    }
 }
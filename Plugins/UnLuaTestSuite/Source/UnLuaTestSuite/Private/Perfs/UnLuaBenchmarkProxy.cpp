@@ -18,10 +18,24 @@ void AUnLuaBenchmarkProxy::NOP()
 {
 }
 
+void AUnLuaBenchmarkProxy::StaticNOP()
+{
+}
+
 void AUnLuaBenchmarkProxy::Simulate(float DeltaTime)
 {
 }
 
+int32 AUnLuaBenchmarkProxy::Sum4(int32 A, int32 B, int32 C, int32 D)
+{
+    return A + B + C + D;
+}
+
+int32 AUnLuaBenchmarkProxy::Sum16(int32 A, int32 B, int32 C, int32 D, int32 E, int32 F, int32 G, int32 H, int32 I, int32 J, int32 K, int32 L, int32 M, int32 N, int32 O, int32 P)
+{
+    return A + B + C + D + E + F + G + H + I + J + K + L + M + N + O + P;
+}
+
 int32 AUnLuaBenchmarkProxy::GetMeshID() const
 {
     return MeshID;
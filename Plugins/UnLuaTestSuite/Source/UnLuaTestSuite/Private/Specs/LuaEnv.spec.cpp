@@ -13,9 +13,14 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "UnLuaBase.h"
+#include "LowLevel.h"
+#include "UnLuaSettings.h"
 #include "UnLuaTemplate.h"
 #include "UnLuaTestHelpers.h"
+#include "Async/ParallelFor.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/CoreDelegates.h"
+#include "Tests/OutParamTest.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -48,6 +53,24 @@ void FLuaEnvSpec::Define()
             TEST_EQUAL(B, 2);
         });
 
+        It(TEXT("从协程找到所属的Lua环境"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::FLuaEnv Env1;
+            const auto L = Env->GetMainState();
+            const auto Thread = lua_newthread(L);
+            TEST_TRUE(UnLua::FLuaEnv::FindEnv(Thread) == Env.Get());
+            TEST_TRUE(UnLua::FLuaEnv::FindEnv(lua_newthread(Env1.GetMainState())) == &Env1);
+            lua_pop(L, 1);
+        });
+
+        It(TEXT("不属于任何Lua环境的lua_State返回空"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto L = luaL_newstate();
+            TEST_TRUE(UnLua::FLuaEnv::FindEnv(L) == nullptr);
+            TEST_TRUE(UnLua::FLuaEnv::FindEnv(lua_newthread(L)) == nullptr);
+            lua_close(L);
+        });
+
         It(TEXT("支持启动脚本和参数"), EAsyncExecution::TaskGraphMainThread, [this]()
         {
             UnLua::FLuaEnv Env1;
@@ -62,6 +85,467 @@ void FLuaEnvSpec::Define()
         });
     });
 
+    Describe(TEXT("从文件系统加载模块"), [this]()
+    {
+        It(TEXT("通过路径索引查找模块文件"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Cache = Env->GetFileSystemCache();
+            const auto Before = Cache->GetStats();
+            TEST_TRUE(Env->DoString(TEXT("require('Tests.Specs.OutParam.OutParamTestStub')")));
+            const auto& After = Cache->GetStats();
+            TEST_EQUAL(After.Loads - Before.Loads, 1);
+            TEST_EQUAL(After.IndexHits - Before.IndexHits, 1);
+            TEST_EQUAL(After.Probes - Before.Probes, 1);
+        });
+
+        It(TEXT("路径索引失效后重新构建"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Cache = Env->GetFileSystemCache();
+            const auto Before = Cache->GetStats();
+            TEST_TRUE(Env->DoString(TEXT("require('Tests.Specs.OutParam.OutParamTestStub')")));
+            Cache->Invalidate();
+            TEST_TRUE(Env->DoString(TEXT("package.loaded['Tests.Specs.OutParam.OutParamTestStub'] = nil; require('Tests.Specs.OutParam.OutParamTestStub')")));
+            TEST_EQUAL(Cache->GetStats().IndexHits - Before.IndexHits, 2);
+        });
+
+        It(TEXT("路径索引区分大小写"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Cache = Env->GetFileSystemCache();
+            const auto Before = Cache->GetStats();
+            Env->DoString(TEXT("pcall(require, 'tests.specs.outparam.outparamteststub')"));
+            TEST_EQUAL(Cache->GetStats().IndexHits - Before.IndexHits, 0);
+        });
+
+        It(TEXT("相对路径不建立索引"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Cache = Env->GetFileSystemCache();
+            const auto Before = Cache->GetStats();
+            TEST_TRUE(Env->DoString(TEXT("package.path = './?.lua;' .. package.path; require('Tests.Specs.OutParam.OutParamTestStub')")));
+            const auto& After = Cache->GetStats();
+            TEST_EQUAL(After.Loads - Before.Loads, 1);
+            TEST_EQUAL(After.IndexHits - Before.IndexHits, 0);
+        });
+
+        It(TEXT("预先在工作线程编译的模块被加载使用"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Cache = Env->GetFileSystemCache();
+            const auto Before = Cache->GetStats();
+            const TArray<FString> ModuleNames = {TEXT("Tests.Specs.OutParam.OutParamTestStub"), TEXT("Tests.Specs.NotExists")};
+            TEST_EQUAL(Cache->Prefetch(Env->GetMainState(), ModuleNames), 1);
+            TEST_TRUE(Env->DoString(TEXT("require('Tests.Specs.OutParam.OutParamTestStub')")));
+            const auto& After = Cache->GetStats();
+            TEST_EQUAL(After.PrefetchHits - Before.PrefetchHits, 1);
+            TEST_EQUAL(After.Probes - Before.Probes, 0);
+        });
+    });
+
+    Describe(TEXT("异步加载的候选对象"), [this]()
+    {
+        It(TEXT("多线程加入5万个候选对象，一次更新全部处理"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            constexpr int32 N = 50000;
+            TArray<UObject*> Objects;
+            Objects.Reserve(N);
+            for (int32 i = 0; i < N; i++)
+                Objects.Add(NewObject<UUnLuaTestStub>());
+
+            const auto Before = Env->GetCandidateStats();
+            ParallelFor(N, [&](int32 i) { Env->AddCandidate(Objects[i]); });
+            TEST_EQUAL(Env->GetCandidateStats().Queued, Before.Queued + N);
+
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            const auto& After = Env->GetCandidateStats();
+            TEST_EQUAL(After.Processed, Before.Processed + N);
+            TEST_EQUAL(After.Deferred, 0);
+            TEST_TRUE(After.MaxBatch >= N);
+        });
+
+        It(TEXT("未完成PostLoad的对象延迟到下次更新"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Loading = NewObject<UUnLuaTestStub>();
+            const auto Loaded = NewObject<UUnLuaTestStub>();
+            Loading->SetFlags(RF_NeedPostLoad);
+
+            const auto Before = Env->GetCandidateStats();
+            Env->AddCandidate(Loading);
+            Env->AddCandidate(Loaded);
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(Env->GetCandidateStats().Processed, Before.Processed + 1);
+            TEST_EQUAL(Env->GetCandidateStats().Deferred, 1);
+
+            Loading->ClearFlags(RF_NeedPostLoad);
+            FCoreDelegates::OnAsyncLoadingFlushUpdate.Broadcast();
+            TEST_EQUAL(Env->GetCandidateStats().Processed, Before.Processed + 2);
+            TEST_EQUAL(Env->GetCandidateStats().Deferred, 0);
+        });
+    });
+
+    Describe(TEXT("对象删除通知"), [this]()
+    {
+        It(TEXT("Lua未引用的对象直接跳过"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UUnLuaTestStub>();
+            const auto Index = GUObjectArray.ObjectToIndex(Object);
+            const auto Touched = Env->GetTouchedObjects();
+            const auto Before = Touched->GetStats();
+            TEST_FALSE(Touched->IsTouched(Index));
+
+            Env->NotifyUObjectDeleted(Object, Index);
+            TEST_EQUAL(Touched->GetStats().Skipped, Before.Skipped + 1);
+        });
+
+        It(TEXT("Lua引用过的对象通知到各注册表并清除标记"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto L = Env->GetMainState();
+            const auto Object = NewObject<UUnLuaTestStub>();
+            const auto Index = GUObjectArray.ObjectToIndex(Object);
+            const auto Touched = Env->GetTouchedObjects();
+            UnLua::PushUObject(L, Object);
+            lua_pop(L, 1);
+            TEST_TRUE(Touched->IsTouched(Index));
+
+            const auto Before = Touched->GetStats();
+            Env->NotifyUObjectDeleted(Object, Index);
+            TEST_FALSE(Touched->IsTouched(Index));
+            TEST_EQUAL(Touched->GetStats().Skipped, Before.Skipped);
+            TEST_EQUAL(Touched->GetStats().Touched, Before.Touched - 1);
+        });
+    });
+
+    Describe(TEXT("缓存类的绑定决策"), [this]()
+    {
+        It(TEXT("未实现接口的类在无动态绑定时被拒绝"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UUnLuaTestStub>();
+            TEST_FALSE(Env->TryBind(Object));
+            TEST_FALSE(Env->TryBind(Object));
+
+            const auto Decision = Env->GetBindDecisions().Find(Object->GetClass());
+            TEST_TRUE(Decision != nullptr);
+            TEST_TRUE(Decision->Kind == UnLua::FLuaEnv::FBindDecision::EKind::Dynamic);
+            TEST_EQUAL(Decision->Rejects, 2);
+            TEST_EQUAL(Decision->Hits, 0);
+        });
+
+        It(TEXT("重置后清空缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            Env->TryBind(NewObject<UUnLuaTestStub>());
+            TEST_TRUE(Env->GetBindDecisions().Num() > 0);
+            Env->ResetBindDecisions();
+            TEST_EQUAL(Env->GetBindDecisions().Num(), 0);
+        });
+
+        It(TEXT("模板对象的绑定决策不缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Archetype = NewObject<UUnLuaTestStub>(GetTransientPackage(), NAME_None, RF_ArchetypeObject);
+            Env->TryBind(Archetype);
+            TEST_TRUE(Env->GetBindDecisions().Find(Archetype->GetClass()) == nullptr);
+        });
+    });
+
+    Describe(TEXT("按对象索引缓存绑定信息"), [this]()
+    {
+        It(TEXT("绑定后可直接查到Lua环境和引用，解绑后清除"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UOutParamTestStub>();
+            TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) == nullptr);
+            TEST_TRUE(Env->TryBind(Object));
+
+            const auto Binding = UnLua::FObjectRegistry::FindBinding(Object);
+            TEST_TRUE(Binding != nullptr);
+            TEST_TRUE(Binding->Env == Env.Get());
+            TEST_EQUAL(Binding->Ref, Env->GetObjectRegistry()->GetBoundRef(Object));
+
+            Env->GetObjectRegistry()->Unbind(Object);
+            TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) == nullptr);
+        });
+
+        It(TEXT("Lua环境销毁时清除"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UOutParamTestStub>();
+            {
+                UnLua::FLuaEnv OtherEnv;
+                TEST_TRUE(OtherEnv.TryBind(Object));
+                TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) != nullptr);
+            }
+            TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) == nullptr);
+        });
+
+        It(TEXT("多个Lua环境绑定同一对象时不记录环境"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UOutParamTestStub>();
+            TEST_TRUE(Env->TryBind(Object));
+            {
+                UnLua::FLuaEnv OtherEnv;
+                TEST_TRUE(OtherEnv.TryBind(Object));
+                TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) == nullptr);
+
+                OtherEnv.GetObjectRegistry()->Unbind(Object);
+                TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) == nullptr);
+                TEST_TRUE(OtherEnv.TryBind(Object));
+            }
+            TEST_TRUE(Env->GetObjectRegistry()->IsBound(Object));
+            TEST_TRUE(UnLua::FObjectRegistry::FindBinding(Object) == nullptr);
+
+            Env->GetObjectRegistry()->Unbind(Object);
+            TEST_TRUE(Env->TryBind(Object));
+            const auto Binding = UnLua::FObjectRegistry::FindBinding(Object);
+            TEST_TRUE(Binding != nullptr && Binding->Env == Env.Get());
+        });
+    });
+
+    Describe(TEXT("按对象索引存放Lua引用"), [this]()
+    {
+        It(TEXT("重复Push返回同一个对象，已绑定的对象返回实例table"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.bEnableDenseObjectTable = true;
+            UnLua::FLuaEnv DenseEnv;
+            Settings.bEnableDenseObjectTable = false;
+
+            const auto L = DenseEnv.GetMainState();
+            const auto Stub = NewObject<UUnLuaTestStub>();
+            UnLua::PushUObject(L, Stub);
+            UnLua::PushUObject(L, Stub);
+            TEST_TRUE(lua_rawequal(L, -1, -2) != 0);
+            TEST_FALSE(DenseEnv.GetObjectRegistry()->IsBound(Stub));
+            lua_pop(L, 2);
+
+            const auto Object = NewObject<UOutParamTestStub>();
+            TEST_TRUE(DenseEnv.TryBind(Object));
+            TEST_TRUE(DenseEnv.GetObjectRegistry()->IsBound(Object));
+            UnLua::PushUObject(L, Object);
+            TEST_TRUE(lua_istable(L, -1));
+            lua_rawgeti(L, LUA_REGISTRYINDEX, DenseEnv.GetObjectRegistry()->GetBoundRef(Object));
+            TEST_TRUE(lua_rawequal(L, -1, -2) != 0);
+            lua_pop(L, 2);
+        });
+
+        It(TEXT("对象删除后清除引用"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.bEnableDenseObjectTable = true;
+            UnLua::FLuaEnv DenseEnv;
+            Settings.bEnableDenseObjectTable = false;
+
+            const auto Object = NewObject<UOutParamTestStub>();
+            TEST_TRUE(DenseEnv.TryBind(Object));
+            DenseEnv.NotifyUObjectDeleted(Object, GUObjectArray.ObjectToIndex(Object));
+            TEST_FALSE(DenseEnv.GetObjectRegistry()->IsBound(Object));
+            TEST_EQUAL(DenseEnv.GetObjectRegistry()->GetBoundRef(Object), LUA_NOREF);
+        });
+
+        It(TEXT("已释放的对象指针不查找索引，直接报错"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.bEnableDenseObjectTable = true;
+            UnLua::FLuaEnv DenseEnv;
+            Settings.bEnableDenseObjectTable = false;
+
+            const auto L = DenseEnv.GetMainState();
+            lua_pushcfunction(L, [](lua_State* L)
+            {
+                UnLua::PushUObject(L, (UObject*)UnLua::LowLevel::ReleasedPtr);
+                return 1;
+            });
+            TEST_EQUAL(lua_pcall(L, 0, 1, 0), LUA_ERRRUN);
+            lua_pop(L, 1);
+        });
+    });
+
+    Describe(TEXT("指定内存分配器"), [this]()
+    {
+        It(TEXT("小内存块从分级内存池中分配"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::FLuaEnv PooledEnv(UnLua::ELuaAllocator::Pooled);
+            const auto Allocator = PooledEnv.GetPoolAllocator();
+            TEST_TRUE(Allocator != nullptr);
+            TEST_TRUE(PooledEnv.DoString(TEXT("local t = {} for i = 1, 1000 do t[i] = { i } end")));
+            PooledEnv.GC();
+
+            const auto& Stats = Allocator->GetStats();
+            TEST_TRUE(Stats.SmallAllocs > 1000);
+            TEST_TRUE(Stats.Pages > 0);
+            TEST_TRUE(Stats.HighWater >= Stats.PageBytes + Stats.LargeBytes);
+            TEST_TRUE(Stats.GetFragmentation() >= 0 && Stats.GetFragmentation() < 1);
+        });
+
+        It(TEXT("默认使用FMemory分配"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::FLuaEnv DefaultEnv(UnLua::ELuaAllocator::Default);
+            TEST_TRUE(DefaultEnv.GetPoolAllocator() == nullptr);
+        });
+    });
+
+    Describe(TEXT("按帧预算调度GC"), [this]()
+    {
+        It(TEXT("增量模式下每帧在预算内步进GC"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Scheduler = Env->GetGCScheduler();
+            Scheduler->SetBudget(1000);
+            Scheduler->SetPolicy(ELuaGCPolicy::Incremental);
+
+            for (int32 i = 0; i < 10; i++)
+            {
+                Env->DoString(TEXT("for i = 1, 10000 do local t = {} end"));
+                Scheduler->Tick();
+            }
+
+            const auto& Stats = Scheduler->GetStats();
+            TEST_FALSE(Stats.bGenerational);
+            TEST_EQUAL(Stats.Frames, 10);
+            TEST_TRUE(Stats.Steps >= 10);
+            TEST_TRUE(Stats.AllocRate > 0);
+        });
+
+        It(TEXT("停止调度后恢复原有的GC配置"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto L = Env->GetMainState();
+            const auto Scheduler = Env->GetGCScheduler();
+            Scheduler->SetBudget(1000);
+            Scheduler->SetPolicy(ELuaGCPolicy::Incremental);
+            Scheduler->Tick();
+            TEST_EQUAL(lua_gc(L, LUA_GCISRUNNING, 0), 0);
+
+            Scheduler->SetBudget(0);
+            Scheduler->Tick();
+            TEST_EQUAL(lua_gc(L, LUA_GCISRUNNING, 0), 1);
+#if 504 == LUA_VERSION_NUM
+            TEST_EQUAL(lua_gc(L, LUA_GCGEN, 0, 0), LUA_GCGEN);
+#endif
+        });
+
+        It(TEXT("每个环境独立设置预算"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::FLuaEnv Other;
+            Env->GetGCScheduler()->SetBudget(1000);
+            TEST_EQUAL(Other.GetGCScheduler()->GetBudget(), GetDefault<UUnLuaSettings>()->GCBudget);
+        });
+    });
+
+    Describe(TEXT("缓存FName和FString"), [this]()
+    {
+        It(TEXT("重复读写同一名字时命中缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto L = Env->GetMainState();
+            const auto Cache = Env->GetNameCache();
+            const FName Name(TEXT("UnLuaTestSocket"));
+
+            Cache->Push(L, Name);
+            Cache->Push(L, Name);
+            TEST_TRUE(lua_rawequal(L, -1, -2));
+            TEST_EQUAL(FString(UTF8_TO_TCHAR(lua_tostring(L, -1))), Name.ToString());
+            TEST_EQUAL(Cache->ToName(L, -1), Name);
+            lua_pop(L, 2);
+
+            lua_pushstring(L, "UnLuaTestTag");
+            TEST_EQUAL(Cache->ToString(L, -1), FString(TEXT("UnLuaTestTag")));
+            TEST_EQUAL(Cache->ToString(L, -1), FString(TEXT("UnLuaTestTag")));
+            lua_pop(L, 1);
+
+            const auto& Stats = Cache->GetStats();
+            TEST_EQUAL(Stats.PushHits, 1);
+            TEST_EQUAL(Stats.PushMisses, 1);
+            TEST_EQUAL(Stats.ReadHits, 2);
+            TEST_EQUAL(Stats.ReadMisses, 1);
+            TEST_EQUAL(Stats.Entries, 2);
+        });
+
+        It(TEXT("超过上限时淘汰最近未使用的条目"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto MaxEntries = UnLua::FLuaNameCache::MaxEntries;
+            UnLua::FLuaNameCache::MaxEntries = 4;
+
+            const auto L = Env->GetMainState();
+            const auto Cache = Env->GetNameCache();
+            const auto Push = [&](int32 i)
+            {
+                Cache->Push(L, FString::Printf(TEXT("UnLuaTestString%d"), i));
+                lua_pop(L, 1);
+            };
+            for (int32 i = 0; i < 4; i++)
+                Push(i);
+            Push(0);
+            Push(4);
+
+            const auto& Stats = Cache->GetStats();
+            TEST_EQUAL(Stats.Evictions, 1);
+            TEST_EQUAL(Stats.Entries, 4);
+
+            const auto Hits = Stats.PushHits;
+            Push(0);
+            TEST_EQUAL(Stats.PushHits, Hits + 1);
+            Push(1);
+            TEST_EQUAL(Stats.PushHits, Hits + 1);
+
+            UnLua::FLuaNameCache::MaxEntries = MaxEntries;
+        });
+    });
+
+    Describe(TEXT("从栈式内存池分配参数缓冲区"), [this]()
+    {
+        It(TEXT("调用UFunction时从内存池分配并回退"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Arena = Env->GetParamBufferArena();
+            Arena->SetEnabled(true);
+            TEST_TRUE(Env->DoString(TEXT("return UE.UKismetMathLibrary.Add_IntInt(1, 2)")));
+            TEST_EQUAL((int32)lua_tointeger(Env->GetMainState(), -1), 3);
+
+            const auto& Stats = Arena->GetStats();
+            TEST_EQUAL(Stats.Pushes, 1);
+            TEST_EQUAL(Stats.Used, 0);
+            TEST_EQUAL(Stats.Depth, 0);
+            TEST_TRUE(Stats.Peak > 0);
+        });
+
+        It(TEXT("嵌套分配按后进先出回退"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Size = UnLua::FParamBufferArena::InitialSize;
+            UnLua::FParamBufferArena::InitialSize = 64;
+
+            const auto Arena = Env->GetParamBufferArena();
+            Arena->SetEnabled(true);
+            const auto A = Arena->Push(48);
+            const auto B = Arena->Push(48); // doesn't fit, goes to a new block
+            const auto C = Arena->Push(16);
+            TEST_EQUAL(Arena->GetStats().Grows, 2);
+            TEST_EQUAL(Arena->GetStats().Depth, 3);
+            TEST_TRUE(A != B);
+
+            Arena->Pop(B); // C is abandoned along with B
+            TEST_EQUAL(Arena->GetStats().Abandoned, 1);
+            TEST_EQUAL(Arena->Push(48), B); // freed block is reused
+            Arena->Rewind(1);
+            TEST_EQUAL(Arena->GetStats().Abandoned, 2);
+            Arena->Pop(A);
+
+            const auto& Stats = Arena->GetStats();
+            TEST_EQUAL(Stats.Depth, 0);
+            TEST_EQUAL(Stats.Used, 0);
+            TEST_EQUAL(Stats.Peak, 112);
+            TEST_EQUAL(Stats.Capacity, 112); // merged into one block sized to peak usage
+            TEST_TRUE(C != nullptr);
+
+            UnLua::FParamBufferArena::InitialSize = Size;
+        });
+
+        It(TEXT("受保护调用成功返回时也回退遗留的缓冲区"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Arena = Env->GetParamBufferArena();
+            Arena->SetEnabled(true);
+            const auto Outer = Arena->Push(16);
+            {
+                // like an error caught by 'pcall' in script, jumping over the pop of this buffer
+                const UnLua::FParamBufferArena::FGuard Guard(Arena);
+                Arena->Push(32);
+            }
+            TEST_EQUAL(Arena->GetStats().Depth, 1);
+            TEST_EQUAL(Arena->GetStats().Abandoned, 1);
+            Arena->Pop(Outer);
+            TEST_EQUAL(Arena->GetStats().Depth, 0);
+        });
+    });
+
     AfterEach([this]
     {
         Env.Reset();
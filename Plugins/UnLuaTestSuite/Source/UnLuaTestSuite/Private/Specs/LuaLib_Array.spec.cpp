@@ -643,6 +643,114 @@ void FUnLuaLibArraySpec::Define()
             TEST_EQUAL(lua_tointeger(L, -1), 2LL);
             TEST_EQUAL(lua_tointeger(L, -2), 1LL);
         });
+
+        It(TEXT("批量转换数值和POD结构体数组"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Integers = UE.TArray(0)
+            local Vectors = UE.TArray(UE.FVector)
+            for i = 1, 1000 do
+                Integers:Add(-i)
+                Vectors:Add(UE.FVector(i, i * 2, i * 3))
+            end
+            local A = Integers:ToTable()
+            local B = Vectors:ToTable()
+            return #A, A[1000], #B, B[1000].Y
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -4), 1000LL);
+            TEST_EQUAL(lua_tointeger(L, -3), -1000LL);
+            TEST_EQUAL(lua_tointeger(L, -2), 1000LL);
+            TEST_EQUAL(lua_tonumber(L, -1), 2000.0);
+        });
+    });
+
+    Describe(TEXT("从LuaTable构造"), [this]
+    {
+        It(TEXT("序列批量写入，非序列逐个写入"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            UnLua::PushUObject(L, NewObject<UUnLuaTestStub>());
+            lua_setglobal(L, "Stub");
+
+            const auto Chunk = R"(
+            local Sequence = {}
+            for i = 1, 1000 do Sequence[i] = i end
+            return Stub:TestForIssue407(Sequence), Stub:TestForIssue407({}), Stub:TestForIssue407({1, 2, Key = 3})
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -3), 1000LL);
+            TEST_EQUAL(lua_tointeger(L, -2), 0LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 3LL);
+        });
+
+        It(TEXT("带空洞的序列跳过nil"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            UnLua::PushUObject(L, NewObject<UUnLuaTestStub>());
+            lua_setglobal(L, "Stub");
+
+            TEST_TRUE(Env->DoString("return Stub:TestForIssue407({1, nil, 3})"));
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+
+        It(TEXT("哈希部分的非序列键不丢失"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            UnLua::PushUObject(L, NewObject<UUnLuaTestStub>());
+            lua_setglobal(L, "Stub");
+
+            TEST_TRUE(Env->DoString("return Stub:TestForIssue407({[1] = 1, [2] = 2, Key = 3})"));
+            TEST_EQUAL(lua_tointeger(L, -1), 3LL);
+        });
+    });
+
+    Describe(TEXT("View"), [this]
+    {
+        It(TEXT("通过类型化视图原地读写数值"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0)
+            for i = 1, 10 do Array:Add(i) end
+            local View = Array:View()
+            View[1] = 100
+            local Slice = View:Slice(3, 5)
+            Slice:Fill(-1)
+            return Array
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            const auto& Array = *(TArray<int32>*)UnLua::GetArray(L, -1);
+            TEST_EQUAL(Array[0], 100);
+            TEST_EQUAL(Array[1], 2);
+            TEST_EQUAL(Array[2], -1);
+            TEST_EQUAL(Array[4], -1);
+            TEST_EQUAL(Array[5], 6);
+        });
+
+        It(TEXT("统计求和、最小值和最大值"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0)
+            for i = 1, 10 do Array:Add(i) end
+            local View = Array:View()
+            local Slice = View:Slice(2, 4)
+            return View:Sum(), View:Min(), View:Max(), #Slice, Slice:Sum(), Slice[1]
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -6), 55LL);
+            TEST_EQUAL(lua_tointeger(L, -5), 1LL);
+            TEST_EQUAL(lua_tointeger(L, -4), 10LL);
+            TEST_EQUAL(lua_tointeger(L, -3), 3LL);
+            TEST_EQUAL(lua_tointeger(L, -2), 9LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+
+        It(TEXT("不支持的元素类型报错"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray('')
+            return pcall(Array.View, Array)
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_FALSE(lua_toboolean(L, -2));
+        });
     });
 
     Describe(TEXT("pairs"), [this]
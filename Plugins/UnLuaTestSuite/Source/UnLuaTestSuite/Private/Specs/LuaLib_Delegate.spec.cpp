@@ -125,6 +125,34 @@ void FUnLuaLibDelegateSpec::Define()
             TEST_EQUAL(Name, TEXT("hello"));
         });
     });
+
+    Describe(TEXT("Handler回收"), [this]()
+    {
+        It(TEXT("绑定过单播委托的Handler不复用"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Registry = Env->GetDelegateRegistry();
+            UnLua::PushUObject(L, NewObject<UUnLuaTestStub>());
+            lua_setglobal(L, "Other");
+
+            const auto Chunk = R"(
+            Counter = 0
+            Stub.SimpleHandler:Bind(Other, function() Counter = Counter + 1 end)
+            Other = nil
+            )";
+            Env->DoString(Chunk);
+            const auto Copied = Stub->SimpleHandler; // e.g. held by timer manager
+            const auto Before = Registry->GetStats();
+
+            lua_gc(L, LUA_GCCOLLECT, 0);
+            CollectGarbage(RF_NoFlags, true);
+
+            TEST_EQUAL(Registry->GetStats().PooledHandlers, Before.PooledHandlers);
+            Env->DoString("Stub.SimpleEvent:Add(Stub, function() end)");
+            Copied.ExecuteIfBound();
+            Env->DoString("return Counter");
+            TEST_EQUAL(lua_tointeger(L, -1), 0LL);
+        });
+    });
 }
 
 #endif
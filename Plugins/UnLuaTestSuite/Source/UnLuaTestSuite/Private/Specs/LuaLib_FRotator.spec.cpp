@@ -100,6 +100,49 @@ void FUnLuaLibFRotatorSpec::Define()
         });
     });
 
+    Describe(TEXT("Add"), [this]
+    {
+        It(TEXT("相加，返回副本"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Rotator1 = UE.FRotator(1,2,3)\
+            local Result = Rotator1:Add(UE.FRotator(4,5,6))\
+            return rawequal(Result, Rotator1), Result\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_FALSE(lua_toboolean(L, -2));
+            const auto& Actual = UnLua::Get<FRotator>(L, -1, UnLua::TType<FRotator>());
+            TEST_EQUAL(Actual, FRotator(5, 7, 9));
+        });
+
+        It(TEXT("原地相加，返回自身"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Rotator1 = UE.FRotator(1,2,3)\
+            return rawequal(Rotator1:AddInPlace(UE.FRotator(4,5,6)), Rotator1), Rotator1\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -2));
+            const auto& Actual = UnLua::Get<FRotator>(L, -1, UnLua::TType<FRotator>());
+            TEST_EQUAL(Actual, FRotator(5, 7, 9));
+        });
+
+        It(TEXT("结果写入Out，返回Out"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Rotator1 = UE.FRotator(1,2,3)\
+            local Out = UE.FRotator()\
+            return rawequal(UE.FRotator.AddInPlace(Out, Rotator1, UE.FRotator(4,5,6)), Out), Out, Rotator1\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -3));
+            const auto& Out = UnLua::Get<FRotator>(L, -2, UnLua::TType<FRotator>());
+            TEST_EQUAL(Out, FRotator(5, 7, 9));
+            const auto& Rotator1 = UnLua::Get<FRotator>(L, -1, UnLua::TType<FRotator>());
+            TEST_EQUAL(Rotator1, FRotator(1, 2, 3));
+        });
+    });
+
     Describe(TEXT("tostring()"), [this]
     {
         It(TEXT("转为字符串"), EAsyncExecution::TaskGraphMainThread, [this]()
@@ -139,6 +139,48 @@ void FUnLuaLibFVectorSpec::Define()
             const auto& Vector = UnLua::Get<FVector>(L, -1, UnLua::TType<FVector>());
             TEST_EQUAL(Vector, FVector(1.1f,2.2f,3.3f) + FVector(4.4f,5.5f,6.6f));
         });
+
+        It(TEXT("原地相加，返回自身"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Vector1 = UE.FVector(1.1,2.2,3.3)\
+            local Vector2 = UE.FVector(4.4,5.5,6.6)\
+            return rawequal(Vector1:AddInPlace(Vector2), Vector1), Vector1\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -2));
+            const auto& Vector = UnLua::Get<FVector>(L, -1, UnLua::TType<FVector>());
+            TEST_EQUAL(Vector, FVector(1.1f,2.2f,3.3f) + FVector(4.4f,5.5f,6.6f));
+        });
+
+        It(TEXT("结果写入Out，返回Out"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Vector1 = UE.FVector(1.1,2.2,3.3)\
+            local Vector2 = UE.FVector(4.4,5.5,6.6)\
+            local Out = UE.FVector()\
+            return rawequal(UE.FVector.AddInPlace(Out, Vector1, Vector2), Out), Out, Vector1\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -3));
+            const auto& Out = UnLua::Get<FVector>(L, -2, UnLua::TType<FVector>());
+            TEST_EQUAL(Out, FVector(1.1f,2.2f,3.3f) + FVector(4.4f,5.5f,6.6f));
+            const auto& Vector1 = UnLua::Get<FVector>(L, -1, UnLua::TType<FVector>());
+            TEST_EQUAL(Vector1, FVector(1.1f,2.2f,3.3f));
+        });
+
+        It(TEXT("Add兼容旧用法，同样原地相加"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Vector1 = UE.FVector(1.1,2.2,3.3)\
+            local Vector2 = UE.FVector(4.4,5.5,6.6)\
+            return rawequal(Vector1:Add(Vector2), Vector1), Vector1\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -2));
+            const auto& Vector = UnLua::Get<FVector>(L, -1, UnLua::TType<FVector>());
+            TEST_EQUAL(Vector, FVector(1.1f,2.2f,3.3f) + FVector(4.4f,5.5f,6.6f));
+        });
     });
 
     Describe(TEXT("Sub"), [this]
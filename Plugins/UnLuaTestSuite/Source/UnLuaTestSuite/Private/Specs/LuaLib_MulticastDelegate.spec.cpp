@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "UnLuaBase.h"
+#include "UnLuaModule.h"
 #include "UnLuaTemplate.h"
 #include "Misc/AutomationTest.h"
 #include "UnLuaTestHelpers.h"
@@ -130,6 +131,57 @@ void FUnLuaLibMulticastDelegateSpec::Define()
         });
     });
 
+    Describe(TEXT("Handler回收"), [this]()
+    {
+        It(TEXT("SelfObject销毁后回收Handler并在下次绑定时复用"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Registry = IUnLuaModule::Get().GetEnv()->GetDelegateRegistry();
+            UnLua::PushUObject(L, NewObject<UUnLuaTestStub>());
+            lua_setglobal(L, "Other");
+
+            const char* Chunk = R"(
+            Stub.SimpleEvent:Add(Other, function() end)
+            Other = nil
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(Stub->SimpleEvent.IsBound());
+            const auto Before = Registry->GetStats();
+
+            lua_gc(L, LUA_GCCOLLECT, 0);
+            CollectGarbage(RF_NoFlags, true);
+
+            const auto& Released = Registry->GetStats();
+            TEST_FALSE(Stub->SimpleEvent.IsBound());
+            TEST_EQUAL(Released.Handlers, Before.Handlers - 1);
+            TEST_EQUAL(Released.PooledHandlers, Before.PooledHandlers + 1);
+            TEST_EQUAL(Released.Links, Before.Links - 1);
+
+            UnLua::RunChunk(L, "Stub.SimpleEvent:Add(Stub, function() end)");
+            const auto& Reused = Registry->GetStats();
+            TEST_TRUE(Stub->SimpleEvent.IsBound());
+            TEST_EQUAL(Reused.Reused, Before.Reused + 1);
+            TEST_EQUAL(Reused.Created, Before.Created);
+        });
+
+        It(TEXT("移除绑定后不残留链接"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Registry = IUnLuaModule::Get().GetEnv()->GetDelegateRegistry();
+            const auto Before = Registry->GetStats();
+            const char* Chunk = R"(
+            local Callback = function() end
+            Stub.SimpleEvent:Add(Stub, Callback)
+            Stub.SimpleEvent:Add(Stub, function() end)
+            Stub.SimpleEvent:Remove(Stub, Callback)
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(Registry->GetStats().Links, Before.Links + 1);
+
+            UnLua::RunChunk(L, "Stub.SimpleEvent:Clear()");
+            TEST_EQUAL(Registry->GetStats().Links, Before.Links);
+            TEST_FALSE(Stub->SimpleEvent.IsBound());
+        });
+    });
+
     AfterEach([this]
     {
         UnLua::Shutdown();
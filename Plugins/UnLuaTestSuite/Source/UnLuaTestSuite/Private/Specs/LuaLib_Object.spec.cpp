@@ -59,6 +59,40 @@ void FUnLuaLibObjectSpec::Define()
         });
     });
 
+    Describe(TEXT("读写属性"), [this]()
+    {
+        It(TEXT("读写原生类的基础类型属性"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Stub = NewObject<UUnLuaTestStub>();
+            UnLua::PushUObject(L, Stub);
+            lua_setglobal(L, "G_Stub");
+
+            const char* Chunk = R"(
+            G_Stub.Counter = 42
+            return G_Stub.Counter
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(Stub->Counter, 42);
+            TEST_EQUAL((int32)lua_tointeger(L, -1), 42);
+        });
+
+        It(TEXT("继承的属性缓存在子类元表中"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            APawn* Pawn = World->SpawnActor<APawn>();
+            UnLua::PushUObject(L, Pawn);
+            lua_setglobal(L, "G_Pawn");
+
+            const char* Chunk = R"(
+            G_Pawn.CustomTimeDilation = 0.5
+            return G_Pawn.CustomTimeDilation, rawget(getmetatable(G_Pawn), "CustomTimeDilation") ~= nil
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(Pawn->CustomTimeDilation, 0.5f);
+            TEST_EQUAL((float)lua_tonumber(L, -2), 0.5f);
+            TEST_TRUE(lua_toboolean(L, -1));
+        });
+    });
+
     Describe(TEXT("IsValid"), [this]()
     {
         It(TEXT("获取对象的有效状态"), EAsyncExecution::TaskGraphMainThread, [this]()
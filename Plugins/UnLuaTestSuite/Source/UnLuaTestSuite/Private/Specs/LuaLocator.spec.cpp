@@ -0,0 +1,149 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "LuaEnvLocator.h"
+#include "LuaModuleLocator.h"
+#include "UnLuaSettings.h"
+#include "UnLuaTestHelpers.h"
+#include "Engine/Engine.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaLocatorSpec, "UnLua.API.Locator", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    UUnLuaTestStubForModuleLocator* Stub;
+    ULuaModuleLocator* ModuleLocator;
+    ULuaEnvLocator_ByGameInstance* EnvLocator;
+    TArray<UWorld*> Worlds;
+
+    int32 GetModuleNameCount() const
+    {
+        return GetDefault<UUnLuaTestStubForModuleLocator>()->GetModuleNameCount;
+    }
+
+    UWorld* CreateWorld(const FName& Name)
+    {
+        const auto World = UWorld::CreateWorld(EWorldType::Game, false, Name);
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+        World->SetGameInstance(NewObject<UGameInstance>(GEngine));
+        Worlds.Add(World);
+        return World;
+    }
+END_DEFINE_SPEC(FLuaLocatorSpec)
+
+void FLuaLocatorSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Stub = NewObject<UUnLuaTestStubForModuleLocator>();
+        Stub->AddToRoot();
+        ModuleLocator = NewObject<ULuaModuleLocator>();
+        ModuleLocator->AddToRoot();
+        EnvLocator = NewObject<ULuaEnvLocator_ByGameInstance>();
+        EnvLocator->AddToRoot();
+    });
+
+    Describe(TEXT("ULuaModuleLocator"), [this]()
+    {
+        It(TEXT("缓存的模块名直接返回，不再调用GetModuleName"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Count = GetModuleNameCount();
+            const auto ModuleName1 = ModuleLocator->Locate(Stub);
+            TEST_EQUAL(GetModuleNameCount(), Count + 1);
+
+            const auto ModuleName2 = ModuleLocator->Locate(Stub);
+            TEST_EQUAL(GetModuleNameCount(), Count + 1);
+            TEST_EQUAL(ModuleName1, FString("Tests.Specs.ModuleLocator.TestStub"));
+            TEST_EQUAL(ModuleName2, ModuleName1);
+        });
+
+        It(TEXT("Invalidate后清空缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            ModuleLocator->Locate(Stub);
+            const auto Count = GetModuleNameCount();
+
+            ModuleLocator->Invalidate();
+            ModuleLocator->Locate(Stub);
+            TEST_EQUAL(GetModuleNameCount(), Count + 1);
+        });
+
+        It(TEXT("热重载后清空缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::FLuaEnv Env;
+            Env.Start();
+            const auto Locator = GetDefault<UUnLuaSettings>()->ModuleLocatorClass.GetDefaultObject();
+            Locator->Locate(Stub);
+            const auto Count = GetModuleNameCount();
+
+            Env.HotReload();
+            Locator->Locate(Stub);
+            TEST_EQUAL(GetModuleNameCount(), Count + 1);
+        });
+    });
+
+    Describe(TEXT("ULuaEnvLocator_ByGameInstance"), [this]()
+    {
+        It(TEXT("同一GameInstance下的World定位到同一个Lua环境"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto World = CreateWorld("UnLuaTest");
+            const auto Env = EnvLocator->Locate(World->GetGameInstance());
+            TEST_EQUAL(EnvLocator->Locate(NewObject<UUnLuaTestStub>(World)), Env);
+            TEST_EQUAL(EnvLocator->Locate(NewObject<UUnLuaTestStub>(World)), Env);
+            TEST_TRUE(Env != EnvLocator->GetDefault());
+        });
+
+        It(TEXT("World清理后不再命中上一次的World"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto World = CreateWorld("UnLuaTest");
+            const auto Env = EnvLocator->Locate(NewObject<UUnLuaTestStub>(World));
+            TEST_EQUAL(Env, EnvLocator->Locate(World->GetGameInstance()));
+
+            FWorldDelegates::OnWorldCleanup.Broadcast(World, true, true);
+            World->SetGameInstance(nullptr);
+            TEST_EQUAL(EnvLocator->Locate(NewObject<UUnLuaTestStub>(World)), EnvLocator->GetDefault());
+        });
+
+        It(TEXT("World清理后移除缓存项"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto World1 = CreateWorld("UnLuaTest1");
+            const auto World2 = CreateWorld("UnLuaTest2");
+            const auto Env1 = EnvLocator->Locate(NewObject<UUnLuaTestStub>(World1));
+            const auto Env2 = EnvLocator->Locate(NewObject<UUnLuaTestStub>(World2));
+            TEST_TRUE(Env1 != Env2);
+
+            FWorldDelegates::OnWorldCleanup.Broadcast(World1, true, true);
+            World1->SetGameInstance(nullptr);
+            TEST_EQUAL(EnvLocator->Locate(NewObject<UUnLuaTestStub>(World1)), EnvLocator->GetDefault());
+            TEST_EQUAL(EnvLocator->Locate(NewObject<UUnLuaTestStub>(World2)), Env2);
+        });
+    });
+
+    AfterEach([this]
+    {
+        EnvLocator->Reset();
+        EnvLocator->RemoveFromRoot();
+        ModuleLocator->RemoveFromRoot();
+        Stub->RemoveFromRoot();
+        for (const auto World : Worlds)
+        {
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+        }
+        Worlds.Empty();
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -18,6 +18,24 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UnLuaBenchmarkFunctionLibrary.generated.h"
 
+namespace UnLua
+{
+    class FLuaEnv;
+}
+
+/**
+ * Result of a timed benchmark case
+ */
+struct FUnLuaBenchmarkResult
+{
+    FString Title;
+    int32 N = 0;
+    double NsPerOp = 0;
+    double OpsPerSec = 0;
+    int64 Allocations = -1; // lua allocations, -1 if the env doesn't count them
+    int64 HeapDelta = 0;    // lua heap delta in bytes
+};
+
 UCLASS()
 class UUnLuaBenchmarkFunctionLibrary : public UBlueprintFunctionLibrary
 {
@@ -36,10 +54,35 @@ public:
     UFUNCTION(BlueprintCallable)
     static void Stop();
 
+    /**
+     * Lua env to measure allocations and heap of, the env of UnLua module is used if not set
+     */
+    static void SetEnv(UnLua::FLuaEnv* InEnv);
+
+    static const TArray<FUnLuaBenchmarkResult>& GetResults() { return Results; }
+
+    /**
+     * Compare results with a baseline json written by Stop()
+     *
+     * @return - descriptions of cases slower than RegressionThreshold or allocating more than baseline
+     */
+    static TArray<FString> CompareWithBaseline(const FString& BaselinePath);
+
+    static FString GetBaselinePath(const FString& Title);
+
+    static float RegressionThreshold; // ratio of ns/op increase, overridden by -UnLuaBenchmarkThreshold=
+
 private:
+    static void GetLuaCounters(int64& OutAllocations, int64& OutHeap);
+
     static TArray<FString> Messages;
+    static TArray<FUnLuaBenchmarkResult> Results;
     static double StartTime;
     static FString StartTitle;
+    static int64 StartAllocations;
+    static int64 StartHeap;
     static float BenchmarkMultiplier;
     static FString BenchmarkTitle;
+    static int32 BenchmarkN;
+    static UnLua::FLuaEnv* Env;
 };
@@ -17,6 +17,8 @@
 #include "GameFramework/Actor.h"
 #include "UnLuaBenchmarkProxy.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUnLuaBenchmarkEvent, int32, Value);
+
 UCLASS()
 class AUnLuaBenchmarkProxy : public AActor
 {
@@ -26,9 +28,18 @@ public:
     UFUNCTION(BlueprintCallable)
     void NOP();
 
+    UFUNCTION(BlueprintCallable)
+    static void StaticNOP();
+
     UFUNCTION(BlueprintCallable)
     void Simulate(float DeltaTime);
 
+    UFUNCTION(BlueprintCallable)
+    int32 Sum4(int32 A, int32 B, int32 C, int32 D);
+
+    UFUNCTION(BlueprintCallable)
+    int32 Sum16(int32 A, int32 B, int32 C, int32 D, int32 E, int32 F, int32 G, int32 H, int32 I, int32 J, int32 K, int32 L, int32 M, int32 N, int32 O, int32 P);
+
     UFUNCTION(BlueprintCallable)
     int32 GetMeshID() const;
 
@@ -82,4 +93,19 @@ public:
 
     UPROPERTY(BlueprintReadWrite)
     TArray<FVector> PredictedPositions;
+
+    UPROPERTY(BlueprintReadWrite)
+    bool bEnabled;
+
+    UPROPERTY(BlueprintReadWrite)
+    float Weight;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName Tag;
+
+    UPROPERTY(BlueprintReadWrite)
+    UObject* Target;
+
+    UPROPERTY(BlueprintAssignable)
+    FUnLuaBenchmarkEvent OnEvent;
 };
@@ -135,6 +135,21 @@ public:
     }
 };
 
+UCLASS()
+class UNLUATESTSUITE_API UUnLuaTestStubForModuleLocator : public UObject, public IUnLuaInterface
+{
+    GENERATED_BODY()
+
+public:
+    virtual FString GetModuleName_Implementation() const override
+    {
+        GetModuleNameCount++;
+        return TEXT("Tests.Specs.ModuleLocator.TestStub");
+    }
+
+    mutable int32 GetModuleNameCount = 0;
+};
+
 UCLASS()
 class UNLUATESTSUITE_API AUnLuaTestActor : public AActor
 {
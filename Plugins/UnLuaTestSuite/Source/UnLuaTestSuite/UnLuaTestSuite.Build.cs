@@ -43,6 +43,7 @@ public class UnLuaTestSuite : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new[]
 			{
+				"Json",
 				"Lua",
 				"UnLua",
 				"UMG"